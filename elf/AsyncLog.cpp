@@ -0,0 +1,121 @@
+/*
+ * AsyncLog.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Georgios Dimitriadis
+ *
+ * Copyright (c) 2026, Georgios Dimitriadis
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include "AsyncLog.h"
+
+using namespace std;
+using namespace elf;
+
+AsyncLog::AsyncLog(ILog& target, const Options& options) :
+	// The lanes have their own lock, so a thread waiting for room in the
+	// ordinary lane holds up nobody else.
+	ILog(target.getMaxSeverity(), concurrent_t()),
+	_target(target),
+	_options(options),
+	_busy(false),
+	_done(false) {
+	_worker = thread(&AsyncLog::deliverLoop, this);
+}
+
+AsyncLog::~AsyncLog() {
+	flush();
+	{
+		lock_guard<mutex> lock(_queueMutex);
+		_done = true;
+	}
+	_queueChanged.notify_all();
+	_worker.join();
+}
+
+void AsyncLog::flush() {
+	{
+		unique_lock<mutex> lock(_queueMutex);
+		_queueChanged.wait(lock, [&] { return _urgent.empty() && _ordinary.empty() && !_busy; });
+	}
+	_target.flush();
+}
+
+void AsyncLog::addEntry(const Entry& entry) {
+	unique_lock<mutex> lock(_queueMutex);
+	enqueue(entry, lock);
+	lock.unlock();
+	_queueChanged.notify_all();
+}
+
+void AsyncLog::addEntries(const Entry* entries, size_t count) {
+	unique_lock<mutex> lock(_queueMutex);
+	for(size_t i=0; i<count; ++i)
+		enqueue(entries[i], lock);
+	lock.unlock();
+	_queueChanged.notify_all();
+}
+
+void AsyncLog::enqueue(const Entry& entry, unique_lock<mutex>& lock) {
+	if(entry.severity <= _options.urgentSeverity) {
+		_urgent.push_back(entry);
+		return;
+	}
+
+	if(_ordinary.size() >= _options.capacity) {
+		if(_options.dropWhenFull) {
+			countDropped();
+			return;
+		}
+		_queueChanged.notify_all();
+		_queueChanged.wait(lock, [&] { return _ordinary.size() < _options.capacity; });
+	}
+	_ordinary.push_back(entry);
+}
+
+void AsyncLog::deliverLoop() {
+	vector<Entry> chunk;
+	unique_lock<mutex> lock(_queueMutex);
+	for(;;) {
+		_queueChanged.wait(lock, [&] { return _done || !_urgent.empty() || !_ordinary.empty(); });
+		if(!_urgent.empty()) {
+			chunk.swap(_urgent);
+			_busy = true;
+			lock.unlock();
+			_target.handle(chunk.data(), chunk.size());
+			_target.flush();
+		} else if(!_ordinary.empty()) {
+			size_t n = min(_options.chunkSize ? _options.chunkSize : 1, _ordinary.size());
+			move(_ordinary.begin(), _ordinary.begin() + static_cast<ptrdiff_t>(n), back_inserter(chunk));
+			_ordinary.erase(_ordinary.begin(), _ordinary.begin() + static_cast<ptrdiff_t>(n));
+			_busy = true;
+			lock.unlock();
+			_queueChanged.notify_all();
+			_target.handle(chunk.data(), chunk.size());
+		} else {
+			return;
+		}
+
+		chunk.clear();
+		lock.lock();
+		_busy = false;
+		_queueChanged.notify_all();
+	}
+}
@@ -0,0 +1,97 @@
+/*
+ * AsyncLog.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Georgios Dimitriadis
+ *
+ * Copyright (c) 2026, Georgios Dimitriadis
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef ASYNCLOG_H_
+#define ASYNCLOG_H_
+#include "ILog.h"
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace elf {
+
+/**
+ * Hands entries to another log on a background thread.
+ *
+ * Entries at or above urgentSeverity go to a separate lane that the worker
+ * always serves first: they overtake the backlog of ordinary entries and
+ * the target is flushed right after writing them. Order is kept within
+ * each lane, not across them.
+ *
+ * The ordinary lane holds at most capacity entries. When it is full the
+ * logging thread waits, or with dropWhenFull the entry is dropped and
+ * counted. The urgent lane is never bounded and never waits, not even
+ * while other threads wait for room in the ordinary one.
+ */
+class AsyncLog : public ILog {
+public:
+	struct Options {
+		Options() :
+			capacity(64*1024),
+			urgentSeverity(elf::ALERT),
+			chunkSize(64),
+			dropWhenFull(false) { }
+
+		std::size_t capacity;
+		Severity urgentSeverity;
+		// Ordinary entries handed to the target at a time, which bounds how
+		// long an urgent entry waits for the worker.
+		std::size_t chunkSize;
+		bool dropWhenFull;
+	};
+
+	// Filters on the target's max severity as it is at construction.
+	AsyncLog(ILog& target, const Options& options=Options());
+	~AsyncLog();
+
+	// Waits until both lanes are delivered, then flushes the target.
+	void flush() override;
+
+protected:
+	void addEntry(const Entry& entry) override;
+	void addEntries(const Entry* entries, std::size_t count) override;
+
+private:
+	void enqueue(const Entry& entry, std::unique_lock<std::mutex>& lock);
+	void deliverLoop();
+
+	ILog& _target;
+	const Options _options;
+
+	std::mutex _queueMutex;
+	std::condition_variable _queueChanged;
+	std::vector<Entry> _urgent;
+	std::deque<Entry> _ordinary;
+	bool _busy;
+	bool _done;
+	std::thread _worker;
+};
+
+}
+
+#endif /* ASYNCLOG_H_ */
@@ -0,0 +1,58 @@
+/*
+ * CallSite.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Georgios Dimitriadis
+ *
+ * Copyright (c) 2026, Georgios Dimitriadis
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include "CallSite.h"
+
+using namespace std;
+using namespace elf;
+
+const size_t CallSite::SLOTS;
+
+CallSite::CallSite(const char* function, const char* file, int line) :
+	location(function, file, line),
+	_facilityKey(nullptr) {
+	for(auto& decision : _decisions)
+		decision.store(0, memory_order_relaxed);
+}
+
+bool CallSite::cached(uint32_t generation, const void* facilityKey, uint32_t& decision) const {
+	if(!facilityKey || _facilityKey.load(memory_order_acquire) != facilityKey)
+		return false;
+
+	uint64_t slot = _decisions[generation % SLOTS].load(memory_order_acquire);
+	if(static_cast<uint32_t>(slot >> 32) != generation)
+		return false;
+	decision = static_cast<uint32_t>(slot);
+	return true;
+}
+
+void CallSite::cache(uint32_t generation, const void* facilityKey, uint32_t decision) const {
+	if(!facilityKey)
+		return;
+	const void* own = nullptr;
+	if(_facilityKey.compare_exchange_strong(own, facilityKey, memory_order_acq_rel) || own == facilityKey)
+		_decisions[generation % SLOTS].store((uint64_t{generation} << 32) | decision, memory_order_release);
+}
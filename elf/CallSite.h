@@ -0,0 +1,83 @@
+/*
+ * CallSite.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Georgios Dimitriadis
+ *
+ * Copyright (c) 2026, Georgios Dimitriadis
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef CALLSITE_H_
+#define CALLSITE_H_
+#include "Logger.h"
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+namespace elf {
+
+/**
+ * A static object per logging statement, created by ELF_SITE:
+ *
+ *   logger << ELF_SITE << ERROR << "connection lost" << end_entry;
+ *
+ * The entry only points at the site, whose location Entry::where() then
+ * returns, so nothing is copied per entry. The site lets stages like
+ * FilterLog cache decisions that depend only on the facility, location
+ * and severity of its entries. A site remembers the facility of its first
+ * entry, by Entry::facilityKey, and caches decisions for that facility
+ * only; entries from the same statement through a logger with another
+ * facility, or without a facility key, are evaluated in full.
+ *
+ * Each cached decision is tagged with a generation that its owner bumps
+ * when its rules change, which invalidates it. A site holds decisions for
+ * up to SLOTS owners at once.
+ */
+class CallSite {
+public:
+	static const std::size_t SLOTS = 4;
+
+	CallSite(const char* function, const char* file, int line);
+
+	CallSite(const CallSite&) = delete;
+	CallSite& operator=(const CallSite&) = delete;
+
+	const Location location;
+
+	// Generations are never zero.
+	bool cached(std::uint32_t generation, const void* facilityKey, std::uint32_t& decision) const;
+	void cache(std::uint32_t generation, const void* facilityKey, std::uint32_t decision) const;
+
+private:
+	mutable std::array<std::atomic<std::uint64_t>, SLOTS> _decisions;
+	mutable std::atomic<const void*> _facilityKey;
+};
+
+template<>
+inline void Logger::LogWriter<CallSite>::write(Logger&, Entry& entry, const CallSite& site) {
+	entry.site = &site;
+}
+
+}
+
+#define ELF_SITE ([](const char* function) -> const elf::CallSite& { \
+		static const elf::CallSite site(function, __FILE__, __LINE__); return site; }(__func__))
+
+#endif /* CALLSITE_H_ */
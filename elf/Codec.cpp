@@ -0,0 +1,51 @@
+/*
+ * Codec.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Georgios Dimitriadis
+ *
+ * Copyright (c) 2026, Georgios Dimitriadis
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include "Codec.h"
+#include <stdexcept>
+#include <zlib.h>
+
+using namespace std;
+using namespace elf;
+
+void ZlibCodec::compress(const char* data, size_t size, string& out) {
+	uLongf outSize = compressBound(static_cast<uLong>(size));
+	out.resize(outSize);
+	int status = compress2(reinterpret_cast<Bytef*>(&out[0]), &outSize,
+			reinterpret_cast<const Bytef*>(data), static_cast<uLong>(size), _level);
+	if(status != Z_OK)
+		throw runtime_error("elf::ZlibCodec: compression failed");
+	out.resize(outSize);
+}
+
+void ZlibCodec::decompress(const char* data, size_t size, size_t rawSize, string& out) {
+	uLongf outSize = static_cast<uLongf>(rawSize);
+	out.resize(rawSize);
+	int status = uncompress(reinterpret_cast<Bytef*>(&out[0]), &outSize,
+			reinterpret_cast<const Bytef*>(data), static_cast<uLong>(size));
+	if(status != Z_OK || outSize != rawSize)
+		throw runtime_error("elf::ZlibCodec: corrupt block");
+}
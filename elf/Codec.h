@@ -0,0 +1,60 @@
+/*
+ * Codec.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Georgios Dimitriadis
+ *
+ * Copyright (c) 2026, Georgios Dimitriadis
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef CODEC_H_
+#define CODEC_H_
+#include <string>
+
+namespace elf {
+
+/**
+ * Block compression used by CompressedFileLog. Every call compresses or
+ * decompresses one self-contained block, no state is carried between calls.
+ */
+class Codec {
+public:
+	virtual ~Codec() { }
+
+	virtual std::string name() const = 0;
+	virtual void compress(const char* data, std::size_t size, std::string& out) = 0;
+	virtual void decompress(const char* data, std::size_t size, std::size_t rawSize, std::string& out) = 0;
+};
+
+class ZlibCodec : public Codec {
+public:
+	ZlibCodec(int level=6) : _level(level) { }
+
+	std::string name() const override { return "zlib"; }
+	void compress(const char* data, std::size_t size, std::string& out) override;
+	void decompress(const char* data, std::size_t size, std::size_t rawSize, std::string& out) override;
+
+private:
+	int _level;
+};
+
+}
+
+#endif /* CODEC_H_ */
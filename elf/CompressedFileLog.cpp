@@ -0,0 +1,304 @@
+/*
+ * CompressedFileLog.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Georgios Dimitriadis
+ *
+ * Copyright (c) 2026, Georgios Dimitriadis
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include "CompressedFileLog.h"
+#include <chrono>
+#include <stdexcept>
+
+using namespace std;
+using namespace elf;
+
+const uint32_t FrameHeader::MAGIC;
+
+static const char FILE_MAGIC[] = {'E', 'L', 'F', 'Z'};
+static const char FILE_VERSION = 1;
+static const size_t FRAME_HEADER_SIZE = 32;
+
+static void putLittleEndian(char* out, uint64_t value, size_t bytes) {
+	for(size_t i=0; i<bytes; ++i)
+		out[i] = static_cast<char>((value >> (8*i)) & 0xff);
+}
+
+static uint64_t getLittleEndian(const char* in, size_t bytes) {
+	uint64_t value = 0;
+	for(size_t i=0; i<bytes; ++i)
+		value |= static_cast<uint64_t>(static_cast<unsigned char>(in[i])) << (8*i);
+	return value;
+}
+
+static void encodeFrameHeader(const FrameHeader& header, char* out) {
+	putLittleEndian(out, header.magic, 4);
+	putLittleEndian(out + 4, header.rawSize, 4);
+	putLittleEndian(out + 8, header.compressedSize, 4);
+	putLittleEndian(out + 12, header.entries, 4);
+	putLittleEndian(out + 16, static_cast<uint64_t>(header.firstTime), 8);
+	putLittleEndian(out + 24, static_cast<uint64_t>(header.lastTime), 8);
+}
+
+static bool readFrameHeader(istream& in, FrameHeader& header) {
+	char bytes[FRAME_HEADER_SIZE];
+	if(!in.read(bytes, sizeof(bytes)))
+		return false;
+	header.magic = static_cast<uint32_t>(getLittleEndian(bytes, 4));
+	header.rawSize = static_cast<uint32_t>(getLittleEndian(bytes + 4, 4));
+	header.compressedSize = static_cast<uint32_t>(getLittleEndian(bytes + 8, 4));
+	header.entries = static_cast<uint32_t>(getLittleEndian(bytes + 12, 4));
+	header.firstTime = static_cast<int64_t>(getLittleEndian(bytes + 16, 8));
+	header.lastTime = static_cast<int64_t>(getLittleEndian(bytes + 24, 8));
+	return header.magic == FrameHeader::MAGIC;
+}
+
+// Returns the codec name, throws unless the stream starts with a file header.
+static string readFileHeader(istream& in, const string& who, const string& path) {
+	char magic[sizeof(FILE_MAGIC)];
+	char version = 0;
+	char length = 0;
+	if(!in.read(magic, sizeof(magic)) || !equal(magic, magic + sizeof(magic), FILE_MAGIC) ||
+			!in.get(version) || version != FILE_VERSION || !in.get(length))
+		throw runtime_error(who + ": not a compressed log: " + path);
+	string name(static_cast<size_t>(static_cast<unsigned char>(length)), '\0');
+	if(!in.read(&name[0], static_cast<streamsize>(name.size())))
+		throw runtime_error(who + ": not a compressed log: " + path);
+	return name;
+}
+
+/**
+ * Calls found with each whole frame after the file header and the offset of
+ * its compressed bytes. Returns where the last whole frame ends; anything
+ * behind it is a frame cut short.
+ */
+template<typename Found>
+static uint64_t scanFrames(istream& in, Found found) {
+	uint64_t end = static_cast<uint64_t>(in.tellg());
+	in.seekg(0, ios::end);
+	const uint64_t size = static_cast<uint64_t>(in.tellg());
+	in.seekg(static_cast<streamoff>(end));
+	FrameHeader header;
+	while(readFrameHeader(in, header)) {
+		const uint64_t offset = end + FRAME_HEADER_SIZE;
+		if(offset + header.compressedSize > size)
+			break;
+		found(header, offset);
+		end = offset + header.compressedSize;
+		in.seekg(static_cast<streamoff>(end));
+	}
+	in.clear();
+	return end;
+}
+
+CompressedFileLog::CompressedFileLog(const string& path, unique_ptr<Codec> codec,
+		Severity maxSeverity, const Options& options) :
+	ILog(maxSeverity),
+	_options(options),
+	_codec(std::move(codec)),
+	_busy(false),
+	_done(false) {
+	// Continue an existing file behind its last whole frame.
+	uint64_t end = 0;
+	{
+		ifstream existing(path, ios::binary);
+		if(existing && existing.peek() != char_traits<char>::eof()) {
+			string name = readFileHeader(existing, "elf::CompressedFileLog", path);
+			if(name != _codec->name())
+				throw runtime_error("elf::CompressedFileLog: " + path + " was written with codec " + name);
+			end = scanFrames(existing, [](const FrameHeader&, uint64_t) { });
+		}
+	}
+	if(!end)
+		_file.open(path, ios::binary|ios::trunc);
+	else
+		_file.open(path, ios::binary|ios::in);
+	if(!_file)
+		throw runtime_error("elf::CompressedFileLog: cannot open " + path);
+
+	if(!end) {
+		string name = _codec->name();
+		_file.write(FILE_MAGIC, sizeof(FILE_MAGIC));
+		_file.put(FILE_VERSION);
+		_file.put(static_cast<char>(name.size()));
+		_file.write(name.data(), static_cast<streamsize>(name.size()));
+	} else {
+		_file.seekp(static_cast<streamoff>(end));
+	}
+	_current.raw.reserve(_options.frameSize);
+	_compressor = thread(&CompressedFileLog::compressLoop, this);
+}
+
+CompressedFileLog::~CompressedFileLog() {
+	flush();
+	{
+		lock_guard<mutex> lock(_queueMutex);
+		_done = true;
+	}
+	_queueChanged.notify_all();
+	_compressor.join();
+}
+
+void CompressedFileLog::flush() {
+	{
+		lock_guard<mutex> lock(getMutex());
+		seal();
+	}
+	unique_lock<mutex> lock(_queueMutex);
+	_queueChanged.wait(lock, [&] { return _queue.empty() && !_busy; });
+	_file.flush();
+}
+
+void CompressedFileLog::addEntry(const Entry& entry) {
+	int64_t time = chrono::duration_cast<chrono::nanoseconds>(entry.time.time_since_epoch()).count();
+	if(!_current.entries)
+		_current.firstTime = time;
+	_current.lastTime = max(_current.lastTime, time);
+	++_current.entries;
+	format_entry(_current.raw, entry);
+
+	if(_current.raw.size() >= _options.frameSize)
+		seal();
+}
+
+void CompressedFileLog::seal() {
+	if(!_current.entries)
+		return;
+
+	unique_lock<mutex> lock(_queueMutex);
+	if(_queue.size() >= _options.maxPendingFrames) {
+		if(_options.dropWhenFull) {
+			countDropped(_current.entries);
+			_current.raw.clear();
+			_current.entries = 0;
+			_current.lastTime = 0;
+			return;
+		}
+		_queueChanged.wait(lock, [&] { return _queue.size() < _options.maxPendingFrames; });
+	}
+
+	_queue.push_back(std::move(_current));
+	_current = Frame();
+	if(!_spareBuffers.empty()) {
+		_current.raw.swap(_spareBuffers.back());
+		_spareBuffers.pop_back();
+	} else {
+		_current.raw.reserve(_options.frameSize);
+	}
+	lock.unlock();
+	_queueChanged.notify_all();
+}
+
+void CompressedFileLog::compressLoop() {
+	string compressed;
+	unique_lock<mutex> lock(_queueMutex);
+	for(;;) {
+		_queueChanged.wait(lock, [&] { return _done || !_queue.empty(); });
+		if(_queue.empty())
+			return;
+
+		Frame frame = std::move(_queue.front());
+		_queue.pop_front();
+		_busy = true;
+		lock.unlock();
+		_queueChanged.notify_all();
+
+		writeFrame(frame, compressed);
+
+		frame.raw.clear();
+		lock.lock();
+		_spareBuffers.push_back(std::move(frame.raw));
+		_busy = false;
+		_queueChanged.notify_all();
+	}
+}
+
+void CompressedFileLog::writeFrame(const Frame& frame, string& compressed) {
+	// A frame the codec fails on is dropped, the others are still written.
+	try {
+		_codec->compress(frame.raw.data(), frame.raw.size(), compressed);
+	} catch(...) {
+		countDropped(frame.entries);
+		return;
+	}
+
+	FrameHeader header;
+	header.magic = FrameHeader::MAGIC;
+	header.rawSize = static_cast<uint32_t>(frame.raw.size());
+	header.compressedSize = static_cast<uint32_t>(compressed.size());
+	header.entries = frame.entries;
+	header.firstTime = frame.firstTime;
+	header.lastTime = frame.lastTime;
+
+	char encoded[FRAME_HEADER_SIZE];
+	encodeFrameHeader(header, encoded);
+	const streampos start = _file.tellp();
+	_file.write(encoded, sizeof(encoded));
+	_file.write(compressed.data(), static_cast<streamsize>(compressed.size()));
+	if(!_file) {
+		// Drop the frame and let the next one overwrite whatever part of it
+		// made it to the file, so readers do not stop at a torn frame.
+		countDropped(frame.entries);
+		_file.clear();
+		if(start != streampos(-1))
+			_file.seekp(start);
+		return;
+	}
+	countBytes(sizeof(encoded) + compressed.size());
+	countWrites();
+}
+
+CompressedFileReader::CompressedFileReader(const string& path, unique_ptr<Codec> codec) :
+	_codec(std::move(codec)),
+	_file(path, ios::binary) {
+	string name = readFileHeader(_file, "elf::CompressedFileReader", path);
+	if(name != _codec->name())
+		throw runtime_error("elf::CompressedFileReader: written with codec " + name);
+
+	scanFrames(_file, [&](const FrameHeader& header, uint64_t offset) {
+		FrameInfo info;
+		info.header = header;
+		info.offset = offset;
+		_frames.push_back(info);
+	});
+}
+
+string CompressedFileReader::read(const FrameInfo& frame) {
+	string compressed(frame.header.compressedSize, '\0');
+	_file.seekg(static_cast<streamoff>(frame.offset));
+	if(!_file.read(&compressed[0], static_cast<streamsize>(compressed.size()))) {
+		_file.clear();
+		throw runtime_error("elf::CompressedFileReader: truncated frame");
+	}
+
+	string raw;
+	_codec->decompress(compressed.data(), compressed.size(), frame.header.rawSize, raw);
+	return raw;
+}
+
+string CompressedFileReader::readRange(int64_t from, int64_t to) {
+	string result;
+	for(const auto& frame : _frames) {
+		if(frame.header.lastTime >= from && frame.header.firstTime <= to)
+			result += read(frame);
+	}
+	return result;
+}
@@ -0,0 +1,139 @@
+/*
+ * CompressedFileLog.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Georgios Dimitriadis
+ *
+ * Copyright (c) 2026, Georgios Dimitriadis
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef COMPRESSEDFILELOG_H_
+#define COMPRESSEDFILELOG_H_
+#include "ILog.h"
+#include "Codec.h"
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace elf {
+
+/**
+ * On-disk layout shared by CompressedFileLog and CompressedFileReader.
+ *
+ * The file starts with "ELFZ", a format version byte, the length of the
+ * codec name and the name. It is followed by frames, each a FrameHeader and
+ * the compressed bytes of whole rendered lines. Frames decode independently
+ * and their headers carry the time range they cover, so a reader can hop
+ * from header to header and only decompress the frames it needs.
+ *
+ * A FrameHeader is stored as its fields in order, little endian, 32 bytes
+ * in all.
+ */
+struct FrameHeader {
+	static const std::uint32_t MAGIC = 0x4d52465a; // "ZFRM"
+
+	std::uint32_t magic;
+	std::uint32_t rawSize;
+	std::uint32_t compressedSize;
+	std::uint32_t entries;
+	std::int64_t firstTime;	// nanoseconds since epoch
+	std::int64_t lastTime;
+};
+
+class CompressedFileLog : public ILog {
+public:
+	struct Options {
+		Options() : frameSize(256*1024), maxPendingFrames(8), dropWhenFull(false) { }
+
+		std::size_t frameSize;
+		std::size_t maxPendingFrames;
+		// When the compressor falls behind, drop frames instead of blocking loggers.
+		bool dropWhenFull;
+	};
+
+	// Appends to an existing file, which must have been written with the
+	// same codec; a frame cut short at its end is overwritten.
+	CompressedFileLog(const std::string& path, std::unique_ptr<Codec> codec,
+			Severity maxSeverity=elf::INFO, const Options& options=Options());
+	~CompressedFileLog();
+
+	// Seals the current frame and waits until everything is on disk.
+	void flush() override;
+
+protected:
+	void addEntry(const Entry& entry) override;
+
+private:
+	struct Frame {
+		Frame() : entries(0), firstTime(0), lastTime(0) { }
+
+		std::string raw;
+		std::uint32_t entries;
+		std::int64_t firstTime;
+		std::int64_t lastTime;
+	};
+
+	void seal();
+	void compressLoop();
+	void writeFrame(const Frame& frame, std::string& compressed);
+
+	const Options _options;
+	std::unique_ptr<Codec> _codec;
+	std::ofstream _file;
+	Frame _current;
+
+	std::mutex _queueMutex;
+	std::condition_variable _queueChanged;
+	std::deque<Frame> _queue;
+	std::vector<std::string> _spareBuffers;
+	bool _busy;
+	bool _done;
+	std::thread _compressor;
+};
+
+class CompressedFileReader {
+public:
+	struct FrameInfo {
+		FrameHeader header;
+		std::uint64_t offset;	// of the compressed bytes
+	};
+
+	CompressedFileReader(const std::string& path, std::unique_ptr<Codec> codec);
+
+	const std::vector<FrameInfo>& frames() const { return _frames; }
+	std::string read(const FrameInfo& frame);
+	// Rendered lines of all frames that overlap [from, to], in nanoseconds since epoch.
+	std::string readRange(std::int64_t from, std::int64_t to);
+
+private:
+	std::unique_ptr<Codec> _codec;
+	std::ifstream _file;
+	std::vector<FrameInfo> _frames;
+};
+
+}
+
+#endif /* COMPRESSEDFILELOG_H_ */
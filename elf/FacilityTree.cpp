@@ -0,0 +1,109 @@
+/*
+ * FacilityTree.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Georgios Dimitriadis
+ *
+ * Copyright (c) 2026, Georgios Dimitriadis
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include "FacilityTree.h"
+#include <functional>
+
+using namespace std;
+using namespace elf;
+
+FacilityTree::FacilityTree(Severity rootThreshold) : _root(rootThreshold) {
+	_root.configured = true;
+	_root.threshold = rootThreshold;
+}
+
+FacilityTree& FacilityTree::instance() {
+	static FacilityTree tree;
+	return tree;
+}
+
+const FacilityTree::threshold_t& FacilityTree::resolve(const string& facility) {
+	lock_guard<mutex> lock(_mutex);
+	return findOrCreate(facility).effective;
+}
+
+void FacilityTree::setThreshold(const string& facility, Severity threshold) {
+	lock_guard<mutex> lock(_mutex);
+	Node& node = findOrCreate(facility);
+	node.configured = true;
+	node.threshold = threshold;
+	propagate(node, threshold);
+}
+
+void FacilityTree::clearThreshold(const string& facility) {
+	lock_guard<mutex> lock(_mutex);
+	Node& node = findOrCreate(facility);
+	if(&node == &_root)
+		return;
+
+	node.configured = false;
+	// The parent's effective value is already settled, inherit it.
+	string::size_type dot = facility.rfind('.');
+	const Node& parent = (dot==string::npos) ? _root : findOrCreate(facility.substr(0, dot));
+	propagate(node, parent.effective.load(memory_order_relaxed));
+}
+
+Severity FacilityTree::getThreshold(const string& facility) {
+	return resolve(facility).load(memory_order_relaxed);
+}
+
+void FacilityTree::reset(Severity rootThreshold) {
+	lock_guard<mutex> lock(_mutex);
+	// Nodes are never removed since loggers hold on to their thresholds.
+	function<void(Node&)> unconfigure = [&](Node& node) {
+		node.configured = false;
+		for(auto& child : node.children)
+			unconfigure(*child.second);
+	};
+	unconfigure(_root);
+	_root.configured = true;
+	_root.threshold = rootThreshold;
+	propagate(_root, rootThreshold);
+}
+
+FacilityTree::Node& FacilityTree::findOrCreate(const string& facility) {
+	Node* node = &_root;
+	string::size_type begin = 0;
+	while(begin < facility.size()) {
+		string::size_type end = facility.find('.', begin);
+		if(end==string::npos)
+			end = facility.size();
+
+		unique_ptr<Node>& child = node->children[facility.substr(begin, end - begin)];
+		if(!child)
+			child.reset(new Node(node->effective.load(memory_order_relaxed)));
+		node = child.get();
+		begin = end + 1;
+	}
+	return *node;
+}
+
+void FacilityTree::propagate(Node& node, Severity inherited) {
+	Severity effective = node.configured ? node.threshold : inherited;
+	node.effective.store(effective, memory_order_relaxed);
+	for(auto& child : node.children)
+		propagate(*child.second, effective);
+}
@@ -0,0 +1,84 @@
+/*
+ * FacilityTree.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Georgios Dimitriadis
+ *
+ * Copyright (c) 2026, Georgios Dimitriadis
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef FACILITYTREE_H_
+#define FACILITYTREE_H_
+#include "ILog.h"
+#include <atomic>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace elf {
+
+/**
+ * Hierarchical severity thresholds keyed on dot separated facility names,
+ * e.g. "db", "db.pool" and "db.pool.conn". A facility without a threshold of
+ * its own inherits the one of its closest configured ancestor.
+ *
+ * Loggers resolve their facility once and keep a reference to its effective
+ * threshold. Reconfiguring updates the effective thresholds in place, so
+ * checking a level stays a single atomic load.
+ */
+class FacilityTree {
+public:
+	typedef std::atomic<Severity> threshold_t;
+
+	FacilityTree(Severity rootThreshold=elf::DEBUG);
+	FacilityTree(const FacilityTree&) = delete;
+	FacilityTree& operator=(const FacilityTree&) = delete;
+
+	static FacilityTree& instance();
+
+	const threshold_t& resolve(const std::string& facility);
+
+	void setThreshold(const std::string& facility, Severity threshold);
+	void clearThreshold(const std::string& facility);
+	Severity getThreshold(const std::string& facility);
+
+	void reset(Severity rootThreshold=elf::DEBUG);
+
+private:
+	struct Node {
+		Node(Severity inherited) : effective(inherited) { }
+
+		threshold_t effective;
+		bool configured = false;
+		Severity threshold = elf::DEBUG;
+		std::map<std::string, std::unique_ptr<Node>> children;
+	};
+
+	Node& findOrCreate(const std::string& facility);
+	static void propagate(Node& node, Severity inherited);
+
+	std::mutex _mutex;
+	Node _root;
+};
+
+}
+
+#endif /* FACILITYTREE_H_ */
@@ -0,0 +1,168 @@
+/*
+ * FileLog.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Georgios Dimitriadis
+ *
+ * Copyright (c) 2026, Georgios Dimitriadis
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include "FileLog.h"
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <mutex>
+#include <system_error>
+#include <fcntl.h>
+#include <unistd.h>
+
+using namespace std;
+using namespace elf;
+
+FileLog::FileLog(const string& path, Severity maxSeverity, const Options& options) :
+	ILog(maxSeverity),
+	_options(options),
+	_fd(::open(path.c_str(), O_WRONLY|O_CREAT|O_APPEND|O_CLOEXEC, 0644)),
+	_slots(max<size_t>(1, min<size_t>(options.maxBatchEntries, IOV_MAX))),
+	_iov(_slots.size()),
+	_pending(0),
+	_pendingBytes(0),
+	_lastSync(clock_t::now()),
+	_bytesSinceSync(0),
+	_done(false) {
+	if(_fd < 0)
+		throw system_error(errno, system_category(), "elf::FileLog: cannot open " + path);
+	if(_options.maxBatchDelay.count() > 0)
+		_flusher = thread(&FileLog::flushLoop, this);
+}
+
+FileLog::~FileLog() {
+	if(_flusher.joinable()) {
+		{
+			lock_guard<mutex> lock(getMutex());
+			_done = true;
+			_batchStarts.notify_one();
+		}
+		_flusher.join();
+	}
+	submit();
+	if(_options.syncInterval.count() || _options.syncBytes)
+		::fdatasync(_fd);
+	::close(_fd);
+}
+
+void FileLog::flush() {
+	lock_guard<mutex> lock(getMutex());
+	submit();
+	maybeSync();
+}
+
+void FileLog::addEntry(const Entry& entry) {
+	if(!_pending) {
+		_batchStarted = clock_t::now();
+		_batchStarts.notify_one();
+	}
+
+	string& slot = _slots[_pending];
+	slot.clear();
+	render(slot, entry);
+	_pendingBytes += slot.size();
+	++_pending;
+
+	if(_pending == _slots.size() || _pendingBytes >= _options.maxBatchBytes ||
+			clock_t::now() - _batchStarted >= _options.maxBatchDelay) {
+		submit();
+		maybeSync();
+	}
+}
+
+void FileLog::render(string& out, const Entry& entry) {
+	format_entry(out, entry);
+}
+
+void FileLog::submitted(size_t, size_t) {
+}
+
+void FileLog::submit() {
+	if(!_pending)
+		return;
+
+	for(size_t i=0; i<_pending; ++i) {
+		_iov[i].iov_base = const_cast<char*>(_slots[i].data());
+		_iov[i].iov_len = _slots[i].size();
+	}
+
+	iovec* iov = _iov.data();
+	int iovcnt = static_cast<int>(_pending);
+	size_t written = 0;
+	while(iovcnt > 0) {
+		ssize_t n = ::writev(_fd, iov, iovcnt);
+		if(n < 0) {
+			if(errno == EINTR)
+				continue;
+			// Count whatever did not make it, partially written entries included.
+			countDropped(static_cast<size_t>(iovcnt));
+			break;
+		}
+		countWrites();
+		written += static_cast<size_t>(n);
+		size_t left = static_cast<size_t>(n);
+		while(iovcnt > 0 && left >= iov->iov_len) {
+			left -= iov->iov_len;
+			++iov;
+			--iovcnt;
+		}
+		if(iovcnt > 0) {
+			iov->iov_base = static_cast<char*>(iov->iov_base) + left;
+			iov->iov_len -= left;
+		}
+	}
+
+	countBytes(written);
+	_bytesSinceSync += written;
+	submitted(_pending - static_cast<size_t>(iovcnt), written);
+	_pending = 0;
+	_pendingBytes = 0;
+}
+
+void FileLog::maybeSync() {
+	bool byBytes = _options.syncBytes && _bytesSinceSync >= _options.syncBytes;
+	bool byTime = _options.syncInterval.count() && _bytesSinceSync &&
+			clock_t::now() - _lastSync >= _options.syncInterval;
+	if(byBytes || byTime) {
+		::fdatasync(_fd);
+		_lastSync = clock_t::now();
+		_bytesSinceSync = 0;
+	}
+}
+
+void FileLog::flushLoop() {
+	unique_lock<mutex> lock(getMutex());
+	while(!_done) {
+		if(!_pending) {
+			_batchStarts.wait(lock);
+		} else if(clock_t::now() - _batchStarted >= _options.maxBatchDelay) {
+			submit();
+			maybeSync();
+		} else {
+			_batchStarts.wait_until(lock, _batchStarted + _options.maxBatchDelay);
+		}
+	}
+}
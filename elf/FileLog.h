@@ -0,0 +1,111 @@
+/*
+ * FileLog.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Georgios Dimitriadis
+ *
+ * Copyright (c) 2026, Georgios Dimitriadis
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef FILELOG_H_
+#define FILELOG_H_
+#include "ILog.h"
+#include <chrono>
+#include <condition_variable>
+#include <string>
+#include <thread>
+#include <vector>
+#include <sys/uio.h>
+
+namespace elf {
+
+/**
+ * File sink that renders entries into reusable per-entry buffers and hands
+ * a whole batch of them to the kernel with a single writev(2).
+ *
+ * A batch is submitted when it holds maxBatchEntries entries or
+ * maxBatchBytes bytes, when its oldest entry is older than maxBatchDelay,
+ * and on flush(). A flusher thread submits batches that reach
+ * maxBatchDelay while the application is idle; with a zero maxBatchDelay
+ * every entry is submitted on its own and no thread is started.
+ *
+ * With stats enabled every writev is counted as a write, so
+ * LogStats::Snapshot::entriesPerWrite() gives the achieved coalescing.
+ */
+class FileLog : public ILog {
+public:
+	struct Options {
+		Options() :
+			maxBatchEntries(256),
+			maxBatchBytes(256*1024),
+			maxBatchDelay(std::chrono::milliseconds{10}),
+			syncInterval(std::chrono::milliseconds{0}),
+			syncBytes(0) { }
+
+		std::size_t maxBatchEntries;
+		std::size_t maxBatchBytes;
+		std::chrono::microseconds maxBatchDelay;
+		// fdatasync(2) once this much time has passed or this many bytes
+		// were written since the last sync. Zero disables the trigger.
+		std::chrono::milliseconds syncInterval;
+		std::size_t syncBytes;
+	};
+
+	FileLog(const std::string& path, Severity maxSeverity=elf::INFO, const Options& options=Options());
+	~FileLog();
+
+	void flush() override;
+
+protected:
+	void addEntry(const Entry& entry) override;
+
+	// Appends the text written for an entry, format_entry by default.
+	virtual void render(std::string& out, const Entry& entry);
+
+	// Called after every batch, under the ILog lock: its first entries
+	// rendered made it to the file whole, and bytes were appended in all,
+	// including the start of the next entry when a write failed midway.
+	virtual void submitted(std::size_t entries, std::size_t bytes);
+
+private:
+	typedef std::chrono::steady_clock clock_t;
+
+	void submit();
+	void maybeSync();
+	void flushLoop();
+
+	const Options _options;
+	int _fd;
+	std::vector<std::string> _slots;
+	std::vector<iovec> _iov;
+	std::size_t _pending;
+	std::size_t _pendingBytes;
+	clock_t::time_point _batchStarted;
+	clock_t::time_point _lastSync;
+	std::size_t _bytesSinceSync;
+
+	std::condition_variable _batchStarts;
+	bool _done;
+	std::thread _flusher;
+};
+
+}
+
+#endif /* FILELOG_H_ */
@@ -0,0 +1,156 @@
+/*
+ * FilterLog.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Georgios Dimitriadis
+ *
+ * Copyright (c) 2026, Georgios Dimitriadis
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include "FilterLog.h"
+
+using namespace std;
+using namespace elf;
+
+namespace {
+
+// Shared by all filters so that a generation names one rule set of one filter.
+atomic<uint32_t> next_generation(1);
+
+uint32_t new_generation() {
+	uint32_t generation;
+	do {
+		generation = next_generation.fetch_add(1, memory_order_relaxed);
+	} while(!generation);
+	return generation;
+}
+
+bool matches_facility(const FilterRule& rule, const string& facility) {
+	const string& prefix = rule.facilityPrefix;
+	return prefix.empty() || facility == prefix
+			|| (facility.size() > prefix.size() && facility.compare(0, prefix.size(), prefix) == 0 && facility[prefix.size()] == '.');
+}
+
+bool matches_static(const FilterRule& rule, const Entry& entry, Severity severity) {
+	if(severity > rule.maxSeverity || !matches_facility(rule, entry.facility))
+		return false;
+	const Location& location = entry.where();
+	const string& file = location.file;
+	if(!rule.file.empty() && (file.size() < rule.file.size() || file.compare(file.size() - rule.file.size(), rule.file.size(), rule.file) != 0))
+		return false;
+	return rule.function.empty() || rule.function == location.function;
+}
+
+bool matches(const FilterRule& rule, const Entry& entry) {
+	if(!matches_static(rule, entry, entry.severity))
+		return false;
+	for(const auto& key : rule.keys) {
+		if(!entry.contains(key))
+			return false;
+	}
+	return true;
+}
+
+// Accepted severities in the low byte, severities that need the entry's
+// custom data in the next.
+uint32_t site_decision(const vector<FilterRule>& rules, FilterRule::Action defaultAction, const Entry& entry) {
+	uint32_t decision = 0;
+	for(int severity = EMERGENCY; severity <= DEBUG; ++severity) {
+		FilterRule::Action action = defaultAction;
+		bool dynamic = false;
+		for(const auto& rule : rules) {
+			if(!matches_static(rule, entry, static_cast<Severity>(severity)))
+				continue;
+			if(!rule.keys.empty()) {
+				dynamic = true;
+				break;
+			}
+			action = rule.action;
+			break;
+		}
+		if(dynamic)
+			decision |= 1u << (8 + severity);
+		else if(action == FilterRule::ACCEPT)
+			decision |= 1u << severity;
+	}
+	return decision;
+}
+
+}
+
+FilterLog::FilterLog(ILog& target, FilterRule::Action defaultAction, const vector<FilterRule>& rules) :
+	ILog(elf::DEBUG, concurrent_t()),
+	_target(target),
+	_generation(0) {
+	setRules(rules, defaultAction);
+}
+
+void FilterLog::setRules(const vector<FilterRule>& rules, FilterRule::Action defaultAction) {
+	shared_ptr<const RuleSet> ruleSet(new RuleSet{rules, defaultAction});
+	atomic_store(&_rules, ruleSet);
+	_generation.store(new_generation(), memory_order_release);
+}
+
+void FilterLog::flush() {
+	_target.flush();
+}
+
+void FilterLog::addEntry(const Entry& entry) {
+	if(accepts(entry))
+		_target.handle(entry);
+}
+
+void FilterLog::addEntries(const Entry* entries, size_t count) {
+	size_t run = 0;
+	for(size_t i=0; i<count; ++i) {
+		if(accepts(entries[i]))
+			continue;
+		if(i > run)
+			_target.handle(entries + run, i - run);
+		run = i + 1;
+	}
+	if(count > run)
+		_target.handle(entries + run, count - run);
+}
+
+bool FilterLog::accepts(const Entry& entry) {
+	const uint32_t generation = _generation.load(memory_order_acquire);
+	const unsigned severity = static_cast<unsigned>(entry.severity) & 7u;
+
+	uint32_t decision = 0;
+	bool known = entry.site && entry.site->cached(generation, entry.facilityKey, decision);
+	shared_ptr<const RuleSet> ruleSet;
+	if(entry.site && !known) {
+		ruleSet = atomic_load(&_rules);
+		decision = site_decision(ruleSet->rules, ruleSet->defaultAction, entry);
+		entry.site->cache(generation, entry.facilityKey, decision);
+		known = true;
+	}
+	if(known && !(decision & (1u << (8 + severity))))
+		return (decision & (1u << severity)) != 0;
+
+	if(!ruleSet)
+		ruleSet = atomic_load(&_rules);
+	for(const auto& rule : ruleSet->rules) {
+		if(matches(rule, entry))
+			return rule.action == FilterRule::ACCEPT;
+	}
+	return ruleSet->defaultAction == FilterRule::ACCEPT;
+}
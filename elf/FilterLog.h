@@ -0,0 +1,105 @@
+/*
+ * FilterLog.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Georgios Dimitriadis
+ *
+ * Copyright (c) 2026, Georgios Dimitriadis
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef FILTERLOG_H_
+#define FILTERLOG_H_
+#include "ILog.h"
+#include "CallSite.h"
+#include <atomic>
+#include <memory>
+#include <string>
+#include <typeindex>
+#include <vector>
+
+namespace elf {
+
+/**
+ * One filter rule. A rule matches an entry when every condition that is
+ * set holds; unset conditions match anything.
+ */
+struct FilterRule {
+	enum Action { ACCEPT, REJECT };
+
+	explicit FilterRule(Action _action=ACCEPT) :
+		action(_action),
+		maxSeverity(elf::DEBUG) { }
+
+	template<typename KeyTag>
+	FilterRule& requireKey() { keys.push_back(typeid(KeyTag)); return *this; }
+
+	Action action;
+	// The facility itself and the facilities below it.
+	std::string facilityPrefix;
+	// Entries at or above this severity.
+	Severity maxSeverity;
+	// Matches the end of the entry's file, so "net/socket.cpp" matches
+	// "/src/net/socket.cpp".
+	std::string file;
+	std::string function;
+	// Custom data keys the entry must all carry.
+	std::vector<std::type_index> keys;
+};
+
+/**
+ * Filtering stage in front of a sink. Rules are tried in order and the
+ * first that matches decides; entries no rule matches get defaultAction.
+ *
+ * For entries logged through ELF_SITE the decisions for all severities
+ * are worked out once per call site and cached in the site, so a cached
+ * entry costs a facility comparison and an atomic load. Rules with custom
+ * data keys that could match a site make it fall back to evaluating its
+ * entries in full. setRules() invalidates every cached decision.
+ */
+class FilterLog : public ILog {
+public:
+	FilterLog(ILog& target, FilterRule::Action defaultAction=FilterRule::ACCEPT,
+			const std::vector<FilterRule>& rules=std::vector<FilterRule>());
+
+	void setRules(const std::vector<FilterRule>& rules, FilterRule::Action defaultAction=FilterRule::ACCEPT);
+
+	// Forwards to the target.
+	void flush() override;
+
+protected:
+	void addEntry(const Entry& entry) override;
+	void addEntries(const Entry* entries, std::size_t count) override;
+
+private:
+	struct RuleSet {
+		std::vector<FilterRule> rules;
+		FilterRule::Action defaultAction;
+	};
+
+	bool accepts(const Entry& entry);
+
+	ILog& _target;
+	std::shared_ptr<const RuleSet> _rules;
+	std::atomic<std::uint32_t> _generation;
+};
+
+}
+
+#endif /* FILTERLOG_H_ */
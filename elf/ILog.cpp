@@ -25,26 +25,115 @@
  * THE SOFTWARE.
  */
 #include "ILog.h"
+#include "CallSite.h"
 #include <mutex>
 
 using namespace std;
 using namespace elf;
 
+ILog::~ILog() {
+	delete _stats.load();
+}
+
 Severity ILog::getMaxSeverity() const {
-	return _maxSeverity;
+	return _maxSeverity.load(memory_order_relaxed);
 }
 
 void ILog::setMaxSeverity(Severity severity) {
-	_maxSeverity = severity;
+	_maxSeverity.store(severity, memory_order_relaxed);
+}
+
+LogStats& ILog::enableStats() {
+	lock_guard<mutex> lock(_mutex);
+	LogStats* stats = _stats.load(memory_order_relaxed);
+	if(!stats) {
+		stats = new LogStats;
+		_stats.store(stats, memory_order_release);
+	}
+	return *stats;
+}
+
+const LogStats* ILog::getStats() const {
+	return _stats.load(memory_order_acquire);
 }
 
 void ILog::handle(const Entry& entry) {
-	if(entry.severity<=_maxSeverity) {
-		lock_guard<mutex> lock(_mutex);
-		this->addEntry(entry);
+	LogStats* stats = _stats.load(memory_order_acquire);
+	if(entry.severity<=_maxSeverity.load(memory_order_relaxed)) {
+		unique_lock<mutex> lock(_mutex, defer_lock);
+		if(_serialized)
+			lock.lock();
+		if(stats) {
+			auto begin = chrono::high_resolution_clock::now();
+			this->addEntry(entry);
+			auto end = chrono::high_resolution_clock::now();
+			stats->countAccepted();
+			stats->addEntryLatency().record(end - begin);
+			stats->endToEndLatency().record(end - entry.time);
+		} else {
+			this->addEntry(entry);
+		}
+	} else if(stats) {
+		stats->countFiltered();
 	}
 }
 
+void ILog::handle(const Entry* entries, size_t count) {
+	LogStats* stats = _stats.load(memory_order_acquire);
+	Severity maxSeverity = _maxSeverity.load(memory_order_relaxed);
+	unique_lock<mutex> lock(_mutex, defer_lock);
+	if(_serialized)
+		lock.lock();
+	size_t first = 0;
+	while(first < count) {
+		if(entries[first].severity > maxSeverity) {
+			if(stats)
+				stats->countFiltered();
+			++first;
+			continue;
+		}
+
+		size_t last = first + 1;
+		while(last < count && entries[last].severity <= maxSeverity)
+			++last;
+
+		if(stats) {
+			auto begin = chrono::high_resolution_clock::now();
+			this->addEntries(entries + first, last - first);
+			auto end = chrono::high_resolution_clock::now();
+			auto perEntry = (end - begin) / static_cast<int>(last - first);
+			for(size_t i=first; i<last; ++i) {
+				stats->countAccepted();
+				stats->addEntryLatency().record(perEntry);
+				stats->endToEndLatency().record(end - entries[i].time);
+			}
+		} else {
+			this->addEntries(entries + first, last - first);
+		}
+		first = last;
+	}
+}
+
+void ILog::addEntries(const Entry* entries, size_t count) {
+	for(size_t i=0; i<count; ++i)
+		this->addEntry(entries[i]);
+}
+
+void ILog::countBytes(size_t bytes) {
+	if(LogStats* stats = _stats.load(memory_order_relaxed))
+		stats->countBytes(bytes);
+}
+
+void ILog::countDropped(size_t entries) {
+	if(LogStats* stats = _stats.load(memory_order_relaxed))
+		stats->countDropped(entries);
+}
+
+void ILog::countWrites(size_t writes) {
+	if(LogStats* stats = _stats.load(memory_order_relaxed))
+		stats->countWrites(writes);
+}
+
 string elf::to_string(Severity severity) {
 	switch(severity) {
 	case EMERGENCY:		return "EMERGENCY";
@@ -60,6 +149,52 @@ string elf::to_string(Severity severity) {
 	return "UNKNOWN_LOG_LEVEL";
 }
 
+string elf::to_utf8(const logstring& str) {
+	string out;
+	out.reserve(str.size());
+	for(log_char c : str) {
+		uint32_t cp = static_cast<uint32_t>(c);
+		if(cp < 0x80) {
+			out += static_cast<char>(cp);
+		} else if(cp < 0x800) {
+			out += static_cast<char>(0xC0 | (cp >> 6));
+			out += static_cast<char>(0x80 | (cp & 0x3F));
+		} else if(cp < 0x10000) {
+			out += static_cast<char>(0xE0 | (cp >> 12));
+			out += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+			out += static_cast<char>(0x80 | (cp & 0x3F));
+		} else {
+			out += static_cast<char>(0xF0 | ((cp >> 18) & 0x07));
+			out += static_cast<char>(0x80 | ((cp >> 12) & 0x3F));
+			out += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+			out += static_cast<char>(0x80 | (cp & 0x3F));
+		}
+	}
+	return out;
+}
+
+void elf::format_entry(string& out, const Entry& entry) {
+	typedef chrono::seconds secs_t;
+	typedef chrono::milliseconds millis_t;
+	int64_t secs = chrono::duration_cast<secs_t>(entry.time.time_since_epoch()).count();
+	int64_t millis = chrono::duration_cast<millis_t>(entry.time.time_since_epoch()).count() - 1000*secs;
+	out += "|";
+	out += to_string(entry.severity);
+	out += "|";
+	out += std::to_string(secs);
+	out += millis < 10 ? ".00" : millis < 100 ? ".0" : ".";
+	out += std::to_string(millis);
+	out += "|";
+	out += entry.facility;
+	out += "|";
+	out += to_utf8(entry.message);
+	out += "\n";
+}
+
+const Location& Entry::where() const {
+	return site ? site->location : location;
+}
+
 Location::Location() : line{-1} {
 }
 
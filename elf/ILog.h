@@ -28,12 +28,14 @@
 #define ILOG_H_
 #include <string>
 #include <mutex>
+#include <atomic>
 #include <chrono>
 #include <sstream>
 #include <typeindex>
 #include <unordered_map>
 #include <boost/optional.hpp>
 #include <boost/any.hpp>
+#include "LogStats.h"
 
 namespace elf {
 
@@ -108,6 +110,7 @@ static logstring to_logstring(const T& t) {
 
 class Logger;
 struct Entry;
+class CallSite;
 
 struct Location {
 	Location();
@@ -138,7 +141,10 @@ OS& operator << (OS& os, const elf::Location& loc) {
 struct Entry {
 	Entry() :
 		severity{DEBUG},
-		time{std::chrono::high_resolution_clock::now()}
+		time{std::chrono::high_resolution_clock::now()},
+		facilityKey{nullptr},
+		site{nullptr},
+		truncated{false}
 	{
 	}
 
@@ -146,7 +152,7 @@ struct Entry {
 	void set(const T& t) { _custom_data[typeid(KeyTag)] = t; }
 
 	template<typename KeyTag, typename T>
-	bool get(T& t) {
+	bool get(T& t) const {
 		auto it = _custom_data.find(typeid(KeyTag));
 		if (it!=_custom_data.end() && it->second.type()==typeid(T)) {
 			t = boost::any_cast<T>(it->second);
@@ -157,37 +163,86 @@ struct Entry {
 	}
 
 	template<typename KeyTag>
-	bool contains() {
+	bool contains() const {
 		return (_custom_data.find(typeid(KeyTag)) != _custom_data.end());
 	}
 
+	bool contains(const std::type_index& key) const {
+		return (_custom_data.find(key) != _custom_data.end());
+	}
+
+	// The location of the site the entry comes from, else location.
+	const Location& where() const;
+
 	Severity severity;
 	logtime time;
 	std::string facility;
+	// Identifies facility by the address of its FacilityTree node, set by
+	// Logger; null for entries made otherwise.
+	const void* facilityKey;
 	Location location;
+	// Set by ELF_SITE, see CallSite.h.
+	const CallSite* site;
 	logstring message;
+	// Set by Logger when text was left out of message while the severity
+	// was below the facility threshold. Logger drops such entries.
+	bool truncated;
 
 private:
 	std::unordered_map<std::type_index, boost::any> _custom_data;
 };
 
+std::string to_utf8(const logstring& str);
+
+/**
+ * Appends the line StreamLog writes for an entry, newline included.
+ */
+void format_entry(std::string& out, const Entry& entry);
+
 class ILog {
 public:
-	ILog(Severity maxSeverity=elf::INFO) : _maxSeverity(maxSeverity) { }
-	virtual ~ILog() { }
+	ILog(Severity maxSeverity=elf::INFO) : _maxSeverity(maxSeverity), _stats(nullptr), _serialized(true) { }
+	virtual ~ILog();
 
 	Severity getMaxSeverity() const;
 	void setMaxSeverity(Severity maxSeverity);
 
+	LogStats& enableStats();
+	const LogStats* getStats() const;
+
 	void handle(const Entry& entry);
+	void handle(const Entry* entries, std::size_t count);
 	virtual void flush() = 0;
 
 protected:
 	virtual void addEntry(const Entry& entry) = 0;
 
+	/**
+	 * Called with consecutive entries that all passed the severity check,
+	 * under the same lock as addEntry. Defaults to one addEntry per entry.
+	 */
+	virtual void addEntries(const Entry* entries, std::size_t count);
+
+	// For sinks to report what they did with an entry when stats are enabled.
+	void countBytes(std::size_t bytes);
+	void countDropped(std::size_t entries=1);
+	void countWrites(std::size_t writes=1);
+
+	// The lock handle() holds around addEntry.
+	std::mutex& getMutex() { return _mutex; }
+
+	/**
+	 * For sinks that synchronize themselves: handle() then calls addEntry
+	 * and addEntries concurrently, without taking the lock above.
+	 */
+	struct concurrent_t { };
+	ILog(Severity maxSeverity, concurrent_t) : _maxSeverity(maxSeverity), _stats(nullptr), _serialized(false) { }
+
 private:
-	Severity _maxSeverity;
+	std::atomic<Severity> _maxSeverity;
+	std::atomic<LogStats*> _stats;
 	std::mutex _mutex;
+	const bool _serialized;
 };
 
 }
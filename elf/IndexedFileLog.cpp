@@ -0,0 +1,164 @@
+/*
+ * IndexedFileLog.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Georgios Dimitriadis
+ *
+ * Copyright (c) 2026, Georgios Dimitriadis
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include "IndexedFileLog.h"
+#include <chrono>
+#include <mutex>
+#include <stdexcept>
+#include <sys/stat.h>
+
+using namespace std;
+using namespace elf;
+
+static const char INDEX_MAGIC[8] = {'E', 'L', 'F', 'I', 'D', 'X', '2', '\n'};
+
+uint64_t IndexBlock::facilityBit(const string& facility) {
+	uint64_t hash = 14695981039346656037ull;
+	for(char c : facility) {
+		hash ^= static_cast<unsigned char>(c);
+		hash *= 1099511628211ull;
+	}
+	return uint64_t{1} << (hash % 64);
+}
+
+uint64_t IndexBlock::facilityBits(const string& facility) {
+	uint64_t bits = 0;
+	for(string::size_type dot = facility.find('.'); dot != string::npos; dot = facility.find('.', dot + 1))
+		bits |= facilityBit(facility.substr(0, dot));
+	return bits | facilityBit(facility);
+}
+
+static IndexBlock emptyBlock(uint64_t offset) {
+	IndexBlock block = {offset, 0, 0, 0, 0, 0, 0};
+	return block;
+}
+
+// Reads the blocks of an index. False if there is no valid header.
+static bool readIndex(const string& indexPath, vector<IndexBlock>& blocks) {
+	ifstream in(indexPath, ios::binary);
+	char magic[sizeof(INDEX_MAGIC)];
+	if(!in.read(magic, sizeof(magic)) || !equal(magic, magic + sizeof(magic), INDEX_MAGIC))
+		return false;
+
+	IndexBlock block;
+	while(in.read(reinterpret_cast<char*>(&block), sizeof(block)))
+		blocks.push_back(block);
+	return true;
+}
+
+static uint64_t fileSize(const string& path) {
+	struct stat st;
+	return ::stat(path.c_str(), &st) == 0 ? static_cast<uint64_t>(st.st_size) : 0;
+}
+
+IndexedFileLog::IndexedFileLog(const string& path, size_t blockSize, Severity maxSeverity, const Options& options) :
+	FileLog(path, maxSeverity, options),
+	_blockSize(blockSize),
+	_block(emptyBlock(fileSize(path))) {
+	_index.open(path + ".idx", ios::binary|ios::app);
+	if(!_index)
+		throw runtime_error("elf::IndexedFileLog: cannot open " + path + ".idx");
+	if(_index.tellp() == 0)
+		_index.write(INDEX_MAGIC, sizeof(INDEX_MAGIC));
+}
+
+IndexedFileLog::~IndexedFileLog() {
+	// ~FileLog would write what is pending without telling the index.
+	FileLog::flush();
+	closeBlock();
+}
+
+void IndexedFileLog::flush() {
+	FileLog::flush();
+	lock_guard<mutex> lock(getMutex());
+	closeBlock();
+	_index.flush();
+}
+
+void IndexedFileLog::render(string& out, const Entry& entry) {
+	FileLog::render(out, entry);
+
+	Rendered rendered;
+	rendered.time = chrono::duration_cast<chrono::nanoseconds>(entry.time.time_since_epoch()).count();
+	rendered.severity = entry.severity;
+	rendered.facilities = IndexBlock::facilityBits(entry.facility);
+	rendered.size = out.size();
+	_rendered.push_back(rendered);
+}
+
+void IndexedFileLog::submitted(size_t entries, size_t bytes) {
+	for(size_t i=0; i<entries; ++i) {
+		const Rendered& rendered = _rendered[i];
+		if(!_block.entries)
+			_block.firstTime = rendered.time;
+		_block.lastTime = max(_block.lastTime, rendered.time);
+		_block.size += rendered.size;
+		++_block.entries;
+		_block.severities |= 1u << rendered.severity;
+		_block.facilities |= rendered.facilities;
+		bytes -= rendered.size;
+
+		if(_block.size >= _blockSize)
+			closeBlock();
+	}
+	_rendered.clear();
+
+	// The start of an entry cut short still takes up room in the file.
+	if(_block.entries)
+		_block.size += bytes;
+	else
+		_block.offset += bytes;
+}
+
+void IndexedFileLog::closeBlock() {
+	if(!_block.entries)
+		return;
+
+	_index.write(reinterpret_cast<const char*>(&_block), sizeof(_block));
+	_block = emptyBlock(_block.offset + _block.size);
+}
+
+LogIndex::LogIndex(const string& logPath) {
+	if(!readIndex(logPath + ".idx", _blocks))
+		throw runtime_error("elf::LogIndex: no index for " + logPath);
+}
+
+vector<IndexBlock> LogIndex::select(int64_t from, int64_t to, Severity maxSeverity, const string& facility) const {
+	const uint32_t severities = (2u << maxSeverity) - 1;
+	const uint64_t facilityBit = facility.empty() ? 0 : IndexBlock::facilityBit(facility);
+
+	vector<IndexBlock> selected;
+	for(const auto& block : _blocks) {
+		if(block.lastTime < from || block.firstTime > to)
+			continue;
+		if(!(block.severities & severities))
+			continue;
+		if(facilityBit && !(block.facilities & facilityBit))
+			continue;
+		selected.push_back(block);
+	}
+	return selected;
+}
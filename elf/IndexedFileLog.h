@@ -0,0 +1,114 @@
+/*
+ * IndexedFileLog.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Georgios Dimitriadis
+ *
+ * Copyright (c) 2026, Georgios Dimitriadis
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef INDEXEDFILELOG_H_
+#define INDEXEDFILELOG_H_
+#include "FileLog.h"
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace elf {
+
+/**
+ * One record of the sparse sidecar index: a block of consecutive lines in
+ * the log file, the time range it covers and which severities and
+ * facilities occur in it.
+ *
+ * The facility bitmap holds one bit per hashed facility name and per
+ * hashed ancestor ("db" and "db.pool" for "db.pool.conn"), so a lookup may
+ * give false positives but never false negatives. The bit of a name is its
+ * 64-bit FNV-1a hash modulo 64.
+ */
+struct IndexBlock {
+	std::uint64_t offset;
+	std::uint64_t size;
+	std::int64_t firstTime;	// nanoseconds since epoch
+	std::int64_t lastTime;
+	std::uint32_t entries;
+	std::uint32_t severities;	// bit n set if an entry of Severity n is in the block
+	std::uint64_t facilities;
+
+	static std::uint64_t facilityBits(const std::string& facility);
+	static std::uint64_t facilityBit(const std::string& facility);
+};
+
+/**
+ * FileLog that also maintains "<path>.idx", one IndexBlock per blockSize
+ * bytes of log, so range queries can seek instead of scanning. Blocks
+ * hold the entries that were written, offsets follow the bytes that were.
+ */
+class IndexedFileLog : public FileLog {
+public:
+	IndexedFileLog(const std::string& path, std::size_t blockSize=64*1024,
+			Severity maxSeverity=elf::INFO, const Options& options=Options());
+	~IndexedFileLog();
+
+	void flush() override;
+
+protected:
+	void render(std::string& out, const Entry& entry) override;
+	void submitted(std::size_t entries, std::size_t bytes) override;
+
+private:
+	// What the index needs of an entry rendered but not yet written.
+	struct Rendered {
+		std::int64_t time;
+		Severity severity;
+		std::uint64_t facilities;
+		std::size_t size;
+	};
+
+	void closeBlock();
+
+	const std::size_t _blockSize;
+	std::ofstream _index;
+	std::vector<Rendered> _rendered;
+	IndexBlock _block;
+};
+
+/**
+ * Reads the sidecar index of an IndexedFileLog.
+ */
+class LogIndex {
+public:
+	explicit LogIndex(const std::string& logPath);
+
+	const std::vector<IndexBlock>& blocks() const { return _blocks; }
+
+	// Blocks overlapping [from, to] holding an entry at least as severe as
+	// maxSeverity, for facility and its descendants if one is given.
+	std::vector<IndexBlock> select(std::int64_t from, std::int64_t to,
+			Severity maxSeverity=elf::DEBUG, const std::string& facility="") const;
+
+private:
+	std::vector<IndexBlock> _blocks;
+};
+
+}
+
+#endif /* INDEXEDFILELOG_H_ */
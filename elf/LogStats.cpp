@@ -0,0 +1,182 @@
+/*
+ * LogStats.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Georgios Dimitriadis
+ *
+ * Copyright (c) 2026, Georgios Dimitriadis
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include "LogStats.h"
+#include <sstream>
+
+using namespace std;
+using namespace elf;
+
+const size_t ValueHistogram::BUCKETS;
+
+ValueHistogram::ValueHistogram() {
+	reset();
+}
+
+void ValueHistogram::record(uint64_t value) {
+	size_t bucket = 0;
+	for(uint64_t n = value; n; n >>= 1)
+		++bucket;
+
+	_buckets[bucket].fetch_add(1, memory_order_relaxed);
+	_sum.fetch_add(value, memory_order_relaxed);
+	uint64_t max = _max.load(memory_order_relaxed);
+	while(value > max && !_max.compare_exchange_weak(max, value, memory_order_relaxed))
+		;
+}
+
+ValueHistogram::Snapshot ValueHistogram::snapshot() const {
+	Snapshot snap;
+	snap.count = 0;
+	for(size_t i=0; i<BUCKETS; ++i) {
+		snap.buckets[i] = _buckets[i].load(memory_order_relaxed);
+		snap.count += snap.buckets[i];
+	}
+	snap.sum = _sum.load(memory_order_relaxed);
+	snap.max = _max.load(memory_order_relaxed);
+	return snap;
+}
+
+void ValueHistogram::reset() {
+	for(auto& bucket : _buckets)
+		bucket.store(0, memory_order_relaxed);
+	_sum.store(0, memory_order_relaxed);
+	_max.store(0, memory_order_relaxed);
+}
+
+ValueHistogram::Snapshot ValueHistogram::snapshotAndReset() {
+	Snapshot snap;
+	snap.count = 0;
+	for(size_t i=0; i<BUCKETS; ++i) {
+		snap.buckets[i] = _buckets[i].exchange(0, memory_order_relaxed);
+		snap.count += snap.buckets[i];
+	}
+	snap.sum = _sum.exchange(0, memory_order_relaxed);
+	snap.max = _max.exchange(0, memory_order_relaxed);
+	return snap;
+}
+
+uint64_t ValueHistogram::bucketUpperBound(size_t bucket) {
+	if(bucket >= 64)
+		return UINT64_MAX;
+	return bucket ? (uint64_t{1} << bucket) - 1 : 0;
+}
+
+uint64_t ValueHistogram::Snapshot::percentile(double q) const {
+	if(!count)
+		return 0;
+
+	uint64_t rank = static_cast<uint64_t>(q * static_cast<double>(count) + 0.5);
+	if(rank < 1)
+		rank = 1;
+	uint64_t seen = 0;
+	for(size_t i=0; i<BUCKETS; ++i) {
+		seen += buckets[i];
+		if(seen >= rank)
+			return min(bucketUpperBound(i), max);
+	}
+	return max;
+}
+
+double ValueHistogram::Snapshot::mean() const {
+	return count ? static_cast<double>(sum) / static_cast<double>(count) : 0.0;
+}
+
+LogStats::LogStats() {
+	reset();
+}
+
+LogStats::Snapshot LogStats::snapshot() const {
+	Snapshot snap;
+	snap.accepted = _accepted.load(memory_order_relaxed);
+	snap.filtered = _filtered.load(memory_order_relaxed);
+	snap.bytes = _bytes.load(memory_order_relaxed);
+	snap.dropped = _dropped.load(memory_order_relaxed);
+	snap.writes = _writes.load(memory_order_relaxed);
+	snap.addEntryLatency = _addEntryLatency.snapshot();
+	snap.endToEndLatency = _endToEndLatency.snapshot();
+	return snap;
+}
+
+void LogStats::reset() {
+	_accepted.store(0, memory_order_relaxed);
+	_filtered.store(0, memory_order_relaxed);
+	_bytes.store(0, memory_order_relaxed);
+	_dropped.store(0, memory_order_relaxed);
+	_writes.store(0, memory_order_relaxed);
+	_addEntryLatency.reset();
+	_endToEndLatency.reset();
+}
+
+double LogStats::Snapshot::entriesPerWrite() const {
+	return writes ? static_cast<double>(accepted) / static_cast<double>(writes) : 0.0;
+}
+
+string LogStats::Snapshot::summary() const {
+	ostringstream oss;
+	oss << "accepted=" << accepted
+		<< " filtered=" << filtered
+		<< " dropped=" << dropped
+		<< " bytes=" << bytes
+		<< " writes=" << writes
+		<< " add_entry_ns{p50=" << addEntryLatency.percentile(0.5)
+		<< ",p99=" << addEntryLatency.percentile(0.99)
+		<< ",max=" << addEntryLatency.max << "}"
+		<< " end_to_end_ns{p50=" << endToEndLatency.percentile(0.5)
+		<< ",p99=" << endToEndLatency.percentile(0.99)
+		<< ",max=" << endToEndLatency.max << "}";
+	return oss.str();
+}
+
+void elf::write_histogram(ostream& os, const string& name, const string& labels, const ValueHistogram::Snapshot& hist) {
+	os << "# TYPE " << name << " histogram\n";
+	uint64_t cumulative = 0;
+	for(size_t i=0; i<ValueHistogram::BUCKETS; ++i) {
+		cumulative += hist.buckets[i];
+		if(hist.buckets[i] || i==0)
+			os << name << "_bucket{" << labels << ",le=\"" << ValueHistogram::bucketUpperBound(i) << "\"} " << cumulative << "\n";
+	}
+	os << name << "_bucket{" << labels << ",le=\"+Inf\"} " << hist.count << "\n";
+	os << name << "_sum{" << labels << "} " << hist.sum << "\n";
+	os << name << "_count{" << labels << "} " << hist.count << "\n";
+}
+
+void LogStats::Snapshot::writePrometheus(ostream& os, const string& sink) const {
+	const pair<const char*, uint64_t> counters[] = {
+		{"elf_entries_accepted_total", accepted},
+		{"elf_entries_filtered_total", filtered},
+		{"elf_entries_dropped_total", dropped},
+		{"elf_bytes_written_total", bytes},
+		{"elf_writes_total", writes},
+	};
+	for(const auto& counter : counters) {
+		os << "# TYPE " << counter.first << " counter\n";
+		os << counter.first << "{sink=\"" << sink << "\"} " << counter.second << "\n";
+	}
+	const string labels = "sink=\"" + sink + "\"";
+	write_histogram(os, "elf_add_entry_latency_ns", labels, addEntryLatency);
+	write_histogram(os, "elf_end_to_end_latency_ns", labels, endToEndLatency);
+}
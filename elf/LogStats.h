@@ -0,0 +1,134 @@
+/*
+ * LogStats.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Georgios Dimitriadis
+ *
+ * Copyright (c) 2026, Georgios Dimitriadis
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef LOGSTATS_H_
+#define LOGSTATS_H_
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+namespace elf {
+
+/**
+ * Lock-free histogram of arbitrary unsigned values with power of two
+ * buckets. Bucket i counts values in [2^(i-1), 2^i), bucket 0 counts zero.
+ */
+class ValueHistogram {
+public:
+	static const std::size_t BUCKETS = 65;
+
+	struct Snapshot {
+		std::array<std::uint64_t, BUCKETS> buckets;
+		std::uint64_t count;
+		std::uint64_t sum;
+		std::uint64_t max;
+
+		std::uint64_t percentile(double q) const;
+		double mean() const;
+	};
+
+	ValueHistogram();
+
+	void record(std::uint64_t value);
+	Snapshot snapshot() const;
+	void reset();
+	// Takes the counts and zeroes them in one pass, losing no records.
+	Snapshot snapshotAndReset();
+
+	static std::uint64_t bucketUpperBound(std::size_t bucket);
+
+private:
+	std::array<std::atomic<std::uint64_t>, BUCKETS> _buckets;
+	std::atomic<std::uint64_t> _sum;
+	std::atomic<std::uint64_t> _max;
+};
+
+/**
+ * A ValueHistogram of durations in nanoseconds; negative ones count as zero.
+ */
+class LatencyHistogram : public ValueHistogram {
+public:
+	void record(std::chrono::nanoseconds duration) {
+		ValueHistogram::record(duration.count() > 0 ? static_cast<std::uint64_t>(duration.count()) : 0);
+	}
+};
+
+/**
+ * Writes a snapshot in the Prometheus text format as the histogram name,
+ * labels being the label list without braces, e.g. sink="file".
+ */
+void write_histogram(std::ostream& os, const std::string& name, const std::string& labels, const ValueHistogram::Snapshot& hist);
+
+/**
+ * Counters kept by an ILog when stats are enabled. All updates are relaxed
+ * atomics, so reading a snapshot from another thread never blocks loggers.
+ */
+class LogStats {
+public:
+	struct Snapshot {
+		std::uint64_t accepted;
+		std::uint64_t filtered;
+		std::uint64_t bytes;
+		std::uint64_t dropped;
+		std::uint64_t writes;
+		LatencyHistogram::Snapshot addEntryLatency;
+		LatencyHistogram::Snapshot endToEndLatency;
+
+		double entriesPerWrite() const;
+		std::string summary() const;
+		void writePrometheus(std::ostream& os, const std::string& sink) const;
+	};
+
+	LogStats();
+
+	void countAccepted() { _accepted.fetch_add(1, std::memory_order_relaxed); }
+	void countFiltered() { _filtered.fetch_add(1, std::memory_order_relaxed); }
+	void countBytes(std::uint64_t n) { _bytes.fetch_add(n, std::memory_order_relaxed); }
+	void countDropped(std::uint64_t n=1) { _dropped.fetch_add(n, std::memory_order_relaxed); }
+	void countWrites(std::uint64_t n=1) { _writes.fetch_add(n, std::memory_order_relaxed); }
+
+	LatencyHistogram& addEntryLatency() { return _addEntryLatency; }
+	LatencyHistogram& endToEndLatency() { return _endToEndLatency; }
+
+	Snapshot snapshot() const;
+	void reset();
+
+private:
+	std::atomic<std::uint64_t> _accepted;
+	std::atomic<std::uint64_t> _filtered;
+	std::atomic<std::uint64_t> _bytes;
+	std::atomic<std::uint64_t> _dropped;
+	std::atomic<std::uint64_t> _writes;
+	LatencyHistogram _addEntryLatency;
+	LatencyHistogram _endToEndLatency;
+};
+
+}
+
+#endif /* LOGSTATS_H_ */
@@ -65,23 +65,45 @@ function<Logger&(Logger&, Entry&)> elf::location(const string& func, const strin
 }
 
 Logger::Logger(ILog& log, const string& facility, Severity defaultSeverity)
-	: _logs(1,&log), _facility(facility), _defaultSeverity(defaultSeverity) {
-
+	: _logs(1,&log), _facility(facility), _defaultSeverity(defaultSeverity),
+	  _threshold(&FacilityTree::instance().resolve(facility)),
+	  _batching(false),
+	  _flusherDone(false) {
 }
 
 Logger::Logger(const string& facility, Severity defaultSeverity)
-	: _logs(), _facility(facility), _defaultSeverity(defaultSeverity) {
-
+	: _logs(), _facility(facility), _defaultSeverity(defaultSeverity),
+	  _threshold(&FacilityTree::instance().resolve(facility)),
+	  _batching(false),
+	  _flusherDone(false) {
 }
 
 Logger::Logger(const Logger& logger) :
 	_logs(logger._logs.begin(), logger._logs.end()),
 	_facility(logger._facility),
-	_defaultSeverity(logger._defaultSeverity) {
+	_defaultSeverity(logger._defaultSeverity),
+	_threshold(logger._threshold),
+	_batching(logger._batching),
+	_batchOptions(logger._batchOptions),
+	_flusherDone(false) {
+	if(_batching)
+		startFlusher();
+}
+
+Logger::~Logger() {
+	stopFlusher();
+	flushBatches();
 }
 
 Logger Logger::duplicate(const string& facility) const {
-	return Logger(_logs.begin(), _logs.end(), facility, _defaultSeverity);
+	Logger logger(_logs.begin(), _logs.end(), facility, _defaultSeverity);
+	if(_batching)
+		logger.enableBatching(_batchOptions);
+	return logger;
+}
+
+const string& Logger::getFacility() const {
+	return _facility;
 }
 
 void Logger::addLog(ILog& log) {
@@ -98,13 +120,138 @@ const std::list<ILog*>& Logger::getLogs() const {
 }
 
 void Logger::flush() {
-	lock_guard<mutex> lock_current_entry(_currentEntryMutex);
+	unique_lock<mutex> lock_current_entry(_currentEntryMutex);
 	map<thread::id, Entry>::iterator entryIt = _currentEntries.find(this_thread::get_id());
-	if(entryIt!=_currentEntries.end()) {
-		Entry& entry = entryIt->second;
+	if(entryIt==_currentEntries.end())
+		return;
+
+	Entry& entry = entryIt->second;
+	if(!isEnabled(entry.severity) || entry.truncated) {
+		_currentEntries.erase(entryIt);
+	} else if(!_batching) {
 		for(auto log : _logs)
 			log->handle(entry);
-
 		_currentEntries.erase(entryIt);
+	} else {
+		Batch& batch = _batches[this_thread::get_id()];
+		auto now = chrono::steady_clock::now();
+		if(batch.entries.empty()) {
+			batch.started = now;
+			_batchesChanged.notify_one();
+		}
+		bool urgent = entry.severity <= _batchOptions.flushSeverity;
+		batch.entries.push_back(std::move(entry));
+		_currentEntries.erase(entryIt);
+
+		if(urgent || batch.entries.size() >= _batchOptions.maxEntries ||
+				now - batch.started >= _batchOptions.maxDelay) {
+			lock_current_entry.unlock();
+			dispatchBatch(this_thread::get_id());
+		}
+	}
+}
+
+void Logger::enableBatching(const BatchOptions& options) {
+	{
+		lock_guard<mutex> lock(_currentEntryMutex);
+		_batchOptions = options;
+		_batching = true;
+		_batchesChanged.notify_one();
+	}
+	if(!_flusher.joinable())
+		startFlusher();
+}
+
+void Logger::disableBatching() {
+	{
+		lock_guard<mutex> lock(_currentEntryMutex);
+		_batching = false;
+	}
+	stopFlusher();
+	flushBatches();
+}
+
+void Logger::flushBatches() {
+	vector<thread::id> threads;
+	{
+		lock_guard<mutex> lock(_currentEntryMutex);
+		for(const auto& batch : _batches)
+			threads.push_back(batch.first);
+	}
+	for(auto thread : threads)
+		dispatchBatch(thread);
+}
+
+void Logger::dispatchBatch(thread::id thread) {
+	lock_guard<mutex> lock_dispatch(_dispatchMutex);
+	vector<Entry> entries;
+	{
+		lock_guard<mutex> lock(_currentEntryMutex);
+		auto batchIt = _batches.find(thread);
+		if(batchIt==_batches.end())
+			return;
+		entries.swap(batchIt->second.entries);
+	}
+
+	if(!entries.empty()) {
+		for(auto log : _logs)
+			log->handle(entries.data(), entries.size());
+	}
+
+	// Hand the buffer back so its capacity is reused by the next batch of the
+	// owning thread, and forget batches of threads that may be long gone.
+	entries.clear();
+	lock_guard<mutex> lock(_currentEntryMutex);
+	auto batchIt = _batches.find(thread);
+	if(batchIt!=_batches.end() && batchIt->second.entries.empty()) {
+		if(thread==this_thread::get_id())
+			batchIt->second.entries.swap(entries);
+		else
+			_batches.erase(batchIt);
+	}
+}
+
+void Logger::startFlusher() {
+	_flusherDone = false;
+	_flusher = thread(&Logger::flushLoop, this);
+}
+
+void Logger::stopFlusher() {
+	if(!_flusher.joinable())
+		return;
+	{
+		lock_guard<mutex> lock(_currentEntryMutex);
+		_flusherDone = true;
+		_batchesChanged.notify_one();
+	}
+	_flusher.join();
+}
+
+void Logger::flushLoop() {
+	unique_lock<mutex> lock(_currentEntryMutex);
+	while(!_flusherDone) {
+		auto now = chrono::steady_clock::now();
+		auto next = chrono::steady_clock::time_point::max();
+		vector<thread::id> due;
+		for(const auto& batch : _batches) {
+			if(batch.second.entries.empty())
+				continue;
+			auto deadline = batch.second.started + _batchOptions.maxDelay;
+			if(deadline <= now)
+				due.push_back(batch.first);
+			else
+				next = min(next, deadline);
+		}
+
+		if(!due.empty()) {
+			lock.unlock();
+			for(auto thread : due)
+				dispatchBatch(thread);
+			lock.lock();
+		} else if(next == chrono::steady_clock::time_point::max()) {
+			_batchesChanged.wait(lock);
+		} else {
+			_batchesChanged.wait_until(lock, next);
+		}
 	}
 }
@@ -27,11 +27,16 @@
 #ifndef LOGGER_H_
 #define LOGGER_H_
 #include "ILog.h"
+#include "FacilityTree.h"
 #include <thread>
 #include <mutex>
+#include <condition_variable>
 
 #include <map>
 #include <list>
+#include <vector>
+#include <chrono>
+#include <functional>
 #include <sstream>
 #include <type_traits>
 
@@ -43,6 +48,25 @@ class Logger {
 	{ static void write(Logger& logger, Entry& entry, const T& data); };
 
 public:
+	/**
+	 * Completed entries are kept in a per-thread batch and handed to the
+	 * logs in one ILog::handle call once the batch holds maxEntries entries,
+	 * its oldest entry is maxDelay old, or an entry at or above
+	 * flushSeverity arrives. While batching is enabled a flusher thread
+	 * hands over batches that reach maxDelay with no entry following.
+	 * flushBatches() hands over what is left.
+	 */
+	struct BatchOptions {
+		BatchOptions() :
+			maxEntries(64),
+			maxDelay(std::chrono::milliseconds{10}),
+			flushSeverity(elf::WARNING) { }
+
+		std::size_t maxEntries;
+		std::chrono::microseconds maxDelay;
+		Severity flushSeverity;
+	};
+
 	typedef std::function<Logger&(Logger&,Entry&)> manipulator_t;
 	typedef Logger& (manipulator_sig_t)(Logger&, Entry&);
 
@@ -51,12 +75,15 @@ public:
 	template<typename InputIterator>
 	Logger(InputIterator logsBegin, InputIterator logsEnd,
 			const std::string& facility, Severity defaultSeverity=elf::INFO)
-				: _logs(logsBegin, logsEnd), _facility(facility), _defaultSeverity(defaultSeverity) {
+				: _logs(logsBegin, logsEnd), _facility(facility), _defaultSeverity(defaultSeverity),
+				  _threshold(&FacilityTree::instance().resolve(facility)),
+				  _batching(false), _flusherDone(false) {
 	}
 
 	Logger(const std::string& facility, Severity defaultSeverity=elf::INFO);
 
 	Logger(const Logger& logger);
+	~Logger();
 
 	template<typename T>
 	Logger& operator<< (const T& data) {
@@ -70,6 +97,7 @@ public:
 				entry = &(_currentEntries[std::this_thread::get_id()]);
 				entry->severity = _defaultSeverity;
 				entry->facility = _facility;
+				entry->facilityKey = _threshold;
 			}
 		}
 		LogWriter<T>::write(*this, *entry, data);
@@ -78,28 +106,65 @@ public:
 
 	Logger duplicate(const std::string& facility) const;
 
+	const std::string& getFacility() const;
+	bool isEnabled(Severity severity) const;
+
 	void addLog(ILog& log);
 	void removeLog(ILog& log);
 	const std::list<ILog*>& getLogs() const;
 	void flush();
 
+	void enableBatching(const BatchOptions& options=BatchOptions());
+	void disableBatching();
+	void flushBatches();
+
 private:
+	struct Batch {
+		std::vector<Entry> entries;
+		std::chrono::steady_clock::time_point started;
+	};
+
 	Logger& operator=(const Logger&);
+	void dispatchBatch(std::thread::id thread);
+	void startFlusher();
+	void stopFlusher();
+	void flushLoop();
 
 	std::list<ILog*> _logs;
 
 	const std::string _facility;
 	const Severity _defaultSeverity;
+	const FacilityTree::threshold_t* _threshold;
 
 	std::mutex _currentEntryMutex;
 	std::map<std::thread::id, Entry> _currentEntries;
 
+	bool _batching;
+	BatchOptions _batchOptions;
+	std::map<std::thread::id, Batch> _batches;
+	// Serializes batch hand-offs so a thread's batches reach the logs in order.
+	std::mutex _dispatchMutex;
+
+	std::condition_variable _batchesChanged;
+	bool _flusherDone;
+	std::thread _flusher;
+
 };
 
-// Default behavior: append data to message
+inline bool Logger::isEnabled(Severity severity) const {
+	return severity <= _threshold->load(std::memory_order_relaxed);
+}
+
+// Default behavior: append data to message, unless the entry's severity is
+// below the facility threshold and the entry is to be dropped anyway. Put
+// the severity before the data it applies to: an entry whose severity is
+// raised after data was left out is dropped rather than logged truncated.
 template<typename T>
-inline void Logger::LogWriter<T>::write(Logger&, Entry& entry, const T& data) {
-	entry.message += to_logstring(data);
+inline void Logger::LogWriter<T>::write(Logger& logger, Entry& entry, const T& data) {
+	if(logger.isEnabled(entry.severity))
+		entry.message += to_logstring(data);
+	else
+		entry.truncated = true;
 }
 
 template<>
@@ -0,0 +1,236 @@
+/*
+ * MetricsLog.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Georgios Dimitriadis
+ *
+ * Copyright (c) 2026, Georgios Dimitriadis
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include "MetricsLog.h"
+#include <sstream>
+#include <thread>
+
+using namespace std;
+using namespace elf;
+
+namespace {
+
+size_t hash_key(const string& facility) {
+	return hash<string>()(facility);
+}
+
+size_t hash_key(const Location& location) {
+	hash<string> hasher;
+	return hasher(location.file) ^ (hasher(location.function) * 31) ^ (static_cast<size_t>(location.line) * 1000003);
+}
+
+bool same_key(const string& a, const string& b) {
+	return a == b;
+}
+
+bool same_key(const Location& a, const Location& b) {
+	return a.line == b.line && a.file == b.file && a.function == b.function;
+}
+
+string key_name(const string& facility) {
+	return facility;
+}
+
+string key_name(const Location& location) {
+	ostringstream oss;
+	oss << location;
+	return oss.str();
+}
+
+string escape_label(const string& value) {
+	string escaped;
+	for(char c : value) {
+		if(c == '"' || c == '\\')
+			escaped += '\\';
+		if(c == '\n') {
+			escaped += "\\n";
+			continue;
+		}
+		escaped += c;
+	}
+	return escaped;
+}
+
+}
+
+const size_t MetricsLog::SEVERITIES;
+
+template<typename Key>
+class MetricsLog::Table {
+public:
+	enum State { EMPTY, CLAIMED, READY };
+
+	struct Slot {
+		Slot() : state(EMPTY), hash(0) {
+			for(auto& count : counts)
+				count.store(0, memory_order_relaxed);
+		}
+
+		atomic<int> state;
+		size_t hash;
+		Key key;
+		array<atomic<uint64_t>, SEVERITIES> counts;
+	};
+
+	explicit Table(size_t maxKeys) : _mask(1), _keys(0), _maxKeys(maxKeys) {
+		while(_mask < maxKeys * 2)
+			_mask <<= 1;
+		_slots.reset(new Slot[_mask]);
+		--_mask;
+	}
+
+	// The slot counting key, claiming one if the key is new; nullptr once
+	// the table holds maxKeys keys.
+	Slot* find(const Key& key) {
+		const size_t hash = hash_key(key);
+		for(size_t i = hash & _mask, probes = 0; probes <= _mask; i = (i + 1) & _mask, ++probes) {
+			Slot& slot = _slots[i];
+			int state = slot.state.load(memory_order_acquire);
+			if(state == EMPTY) {
+				if(_keys.load(memory_order_relaxed) >= _maxKeys)
+					return nullptr;
+				if(slot.state.compare_exchange_strong(state, CLAIMED, memory_order_acquire)) {
+					_keys.fetch_add(1, memory_order_relaxed);
+					slot.hash = hash;
+					slot.key = key;
+					slot.state.store(READY, memory_order_release);
+					return &slot;
+				}
+			}
+			// Another thread is writing the key of this slot, which may be ours.
+			while(state == CLAIMED) {
+				this_thread::yield();
+				state = slot.state.load(memory_order_acquire);
+			}
+			if(slot.hash == hash && same_key(slot.key, key))
+				return &slot;
+		}
+		return nullptr;
+	}
+
+	void collect(map<string, Counts>& out, bool reset) {
+		for(size_t i=0; i<=_mask; ++i) {
+			Slot& slot = _slots[i];
+			if(slot.state.load(memory_order_acquire) != READY)
+				continue;
+			Counts& counts = out[key_name(slot.key)];
+			for(size_t s=0; s<SEVERITIES; ++s)
+				counts.bySeverity[s] += reset ? slot.counts[s].exchange(0, memory_order_relaxed)
+						: slot.counts[s].load(memory_order_relaxed);
+		}
+	}
+
+private:
+	unique_ptr<Slot[]> _slots;
+	size_t _mask;
+	atomic<size_t> _keys;
+	const size_t _maxKeys;
+};
+
+MetricsLog::MetricsLog(Severity maxSeverity, const Options& options) :
+	ILog(maxSeverity, concurrent_t()),
+	_facilities(new Table<string>(options.maxFacilities)),
+	_sites(new Table<Location>(options.maxSites)),
+	_overflow(0) {
+}
+
+MetricsLog::~MetricsLog() {
+}
+
+void MetricsLog::addEntry(const Entry& entry) {
+	const size_t severity = static_cast<size_t>(entry.severity) < SEVERITIES ? static_cast<size_t>(entry.severity) : SEVERITIES - 1;
+
+	if(auto slot = _facilities->find(entry.facility))
+		slot->counts[severity].fetch_add(1, memory_order_relaxed);
+	else
+		_overflow.fetch_add(1, memory_order_relaxed);
+
+	const Location& location = entry.where();
+	if(location.line > 0 || location.file.size() || location.function.size()) {
+		if(auto slot = _sites->find(location))
+			slot->counts[severity].fetch_add(1, memory_order_relaxed);
+		else
+			_overflow.fetch_add(1, memory_order_relaxed);
+	}
+
+	uint64_t value;
+	if(_fieldValue && _fieldValue(entry, value))
+		_field.record(value);
+}
+
+MetricsLog::Snapshot MetricsLog::snapshot(bool reset) {
+	Snapshot snap;
+	_facilities->collect(snap.facilities, reset);
+	_sites->collect(snap.sites, reset);
+	snap.overflow = reset ? _overflow.exchange(0, memory_order_relaxed) : _overflow.load(memory_order_relaxed);
+	snap.fieldName = _fieldName;
+	snap.field = reset ? _field.snapshotAndReset() : _field.snapshot();
+	return snap;
+}
+
+uint64_t MetricsLog::Counts::total(Severity maxSeverity) const {
+	uint64_t sum = 0;
+	for(size_t s=0; s<=static_cast<size_t>(maxSeverity) && s<SEVERITIES; ++s)
+		sum += bySeverity[s];
+	return sum;
+}
+
+uint64_t MetricsLog::Snapshot::count(Severity maxSeverity, const string& facility) const {
+	uint64_t sum = 0;
+	for(const auto& counted : facilities) {
+		const string& name = counted.first;
+		if(facility.empty() || name == facility
+				|| (name.size() > facility.size() && name.compare(0, facility.size(), facility) == 0 && name[facility.size()] == '.'))
+			sum += counted.second.total(maxSeverity);
+	}
+	return sum;
+}
+
+void MetricsLog::Snapshot::writePrometheus(ostream& os, const string& log) const {
+	const pair<const char*, const map<string, Counts>*> tables[] = {
+		{"facility", &facilities},
+		{"site", &sites},
+	};
+	for(const auto& table : tables) {
+		const string metric = string("elf_") + table.first + "_entries_total";
+		os << "# TYPE " << metric << " counter\n";
+		for(const auto& counted : *table.second) {
+			for(size_t s=0; s<SEVERITIES; ++s) {
+				if(!counted.second.bySeverity[s])
+					continue;
+				os << metric << "{log=\"" << log << "\"," << table.first << "=\"" << escape_label(counted.first)
+				   << "\",severity=\"" << to_string(static_cast<Severity>(s)) << "\"} " << counted.second.bySeverity[s] << "\n";
+			}
+		}
+	}
+	os << "# TYPE elf_metrics_overflow_total counter\n";
+	os << "elf_metrics_overflow_total{log=\"" << log << "\"} " << overflow << "\n";
+
+	if(fieldName.empty())
+		return;
+	const string labels = "log=\"" + log + "\",field=\"" + escape_label(fieldName) + "\"";
+	write_histogram(os, "elf_field", labels, field);
+}
@@ -0,0 +1,134 @@
+/*
+ * MetricsLog.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Georgios Dimitriadis
+ *
+ * Copyright (c) 2026, Georgios Dimitriadis
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef METRICSLOG_H_
+#define METRICSLOG_H_
+#include "ILog.h"
+#include <array>
+#include <functional>
+#include <map>
+#include <memory>
+#include <ostream>
+#include <string>
+
+namespace elf {
+
+/**
+ * Sink that writes nothing and counts entries instead: by facility and
+ * severity, and by call site (function, file and line) for entries that
+ * carry a location. Put it next to the real sinks with a lower max
+ * severity to keep rates of entries those sinks never see.
+ *
+ * Counting takes no lock. Keys live in fixed-size open addressing tables
+ * that only ever grow by claiming an empty slot; once a table holds its
+ * maximum number of keys, entries with new keys are counted as overflow.
+ *
+ * Optionally the numeric value of one custom data field is recorded into
+ * a power of two histogram, see recordField().
+ */
+class MetricsLog : public ILog {
+public:
+	static const std::size_t SEVERITIES = elf::DEBUG + 1;
+
+	struct Options {
+		Options() :
+			maxFacilities(1024),
+			maxSites(4096) { }
+
+		std::size_t maxFacilities;
+		std::size_t maxSites;
+	};
+
+	struct Counts {
+		Counts() { bySeverity.fill(0); }
+
+		std::array<std::uint64_t, SEVERITIES> bySeverity;
+
+		// Entries at or above the given severity.
+		std::uint64_t total(Severity maxSeverity=elf::DEBUG) const;
+	};
+
+	struct Snapshot {
+		std::map<std::string, Counts> facilities;
+		// Keyed by "function @ file:line".
+		std::map<std::string, Counts> sites;
+		std::uint64_t overflow;
+		std::string fieldName;
+		ValueHistogram::Snapshot field;
+
+		// Entries at or above maxSeverity from facility and the facilities
+		// below it; an empty facility counts everything.
+		std::uint64_t count(Severity maxSeverity, const std::string& facility="") const;
+		void writePrometheus(std::ostream& os, const std::string& log) const;
+	};
+
+	MetricsLog(Severity maxSeverity=elf::DEBUG, const Options& options=Options());
+	~MetricsLog();
+
+	/**
+	 * Records the value of the custom data stored under KeyTag as T into
+	 * the field histogram; negative values are recorded as zero. Call it
+	 * before the log is in use.
+	 */
+	template<typename KeyTag, typename T>
+	void recordField(const std::string& name);
+
+	// With reset the counts are taken and zeroed in one pass, so no entry
+	// is lost between two snapshots. Keys stay in their tables.
+	Snapshot snapshot(bool reset=false);
+
+	void flush() override { }
+
+protected:
+	void addEntry(const Entry& entry) override;
+
+private:
+	template<typename Key> class Table;
+
+	std::unique_ptr<Table<std::string>> _facilities;
+	std::unique_ptr<Table<Location>> _sites;
+	std::atomic<std::uint64_t> _overflow;
+
+	std::string _fieldName;
+	std::function<bool(const Entry&, std::uint64_t&)> _fieldValue;
+	ValueHistogram _field;
+};
+
+template<typename KeyTag, typename T>
+void MetricsLog::recordField(const std::string& name) {
+	_fieldName = name;
+	_fieldValue = [](const Entry& entry, std::uint64_t& value) {
+		T t;
+		if(!entry.get<KeyTag>(t))
+			return false;
+		value = static_cast<std::uint64_t>(t > T() ? t : T());
+		return true;
+	};
+}
+
+}
+
+#endif /* METRICSLOG_H_ */
@@ -0,0 +1,132 @@
+/*
+ * ShardedLog.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Georgios Dimitriadis
+ *
+ * Copyright (c) 2026, Georgios Dimitriadis
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include "ShardedLog.h"
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <sched.h>
+
+using namespace std;
+using namespace elf;
+
+ShardedLog::ShardedLog(ILog& target, const Options& options) :
+	ILog(target.getMaxSeverity(), concurrent_t()),
+	_target(target),
+	_options(options),
+	_done(false) {
+	size_t shards = _options.shards ? _options.shards : max(1u, thread::hardware_concurrency());
+	for(size_t i=0; i<shards; ++i) {
+		_shards.emplace_back(new Shard);
+		_shards.back()->entries.reserve(_options.shardCapacity);
+	}
+	_merger = thread(&ShardedLog::drainLoop, this);
+}
+
+ShardedLog::~ShardedLog() {
+	{
+		lock_guard<mutex> lock(_wakeMutex);
+		_done = true;
+	}
+	_wake.notify_all();
+	_merger.join();
+	flush();
+}
+
+void ShardedLog::flush() {
+	drain();
+	_target.flush();
+}
+
+ShardedLog::Shard& ShardedLog::currentShard() {
+	int cpu = ::sched_getcpu();
+	size_t index = cpu >= 0 ? static_cast<size_t>(cpu) : hash<thread::id>()(this_thread::get_id());
+	return *_shards[index % _shards.size()];
+}
+
+void ShardedLog::addEntry(const Entry& entry) {
+	addEntries(&entry, 1);
+}
+
+void ShardedLog::addEntries(const Entry* entries, size_t count) {
+	while(count) {
+		Shard& shard = currentShard();
+		{
+			lock_guard<mutex> lock(shard.mutex);
+			size_t room = _options.shardCapacity > shard.entries.size() ? _options.shardCapacity - shard.entries.size() : 0;
+			size_t n = min(room, count);
+			shard.entries.insert(shard.entries.end(), entries, entries + n);
+			entries += n;
+			count -= n;
+			if(!count)
+				return;
+		}
+
+		if(_options.dropWhenFull) {
+			countDropped(count);
+			return;
+		}
+		_wake.notify_one();
+		this_thread::yield();
+	}
+}
+
+void ShardedLog::drain() {
+	lock_guard<mutex> lock(_drainMutex);
+	for(auto& shard : _shards) {
+		{
+			lock_guard<mutex> shardLock(shard->mutex);
+			if(shard->entries.empty())
+				continue;
+			_spare.swap(shard->entries);
+		}
+		if(_merged.empty())
+			_merged.swap(_spare);
+		else
+			move(_spare.begin(), _spare.end(), back_inserter(_merged));
+		_spare.clear();
+		_spare.reserve(_options.shardCapacity);
+	}
+
+	if(_merged.empty())
+		return;
+
+	auto earlier = [](const Entry& a, const Entry& b) { return a.time < b.time; };
+	if(_options.ordering == TIMESTAMP && !is_sorted(_merged.begin(), _merged.end(), earlier))
+		stable_sort(_merged.begin(), _merged.end(), earlier);
+	_target.handle(_merged.data(), _merged.size());
+	_merged.clear();
+}
+
+void ShardedLog::drainLoop() {
+	unique_lock<mutex> lock(_wakeMutex);
+	while(!_done) {
+		_wake.wait_for(lock, _options.drainInterval);
+		lock.unlock();
+		drain();
+		lock.lock();
+	}
+}
@@ -0,0 +1,107 @@
+/*
+ * ShardedLog.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Georgios Dimitriadis
+ *
+ * Copyright (c) 2026, Georgios Dimitriadis
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef SHARDEDLOG_H_
+#define SHARDEDLOG_H_
+#include "ILog.h"
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace elf {
+
+/**
+ * Spreads entries over per-CPU shards so logging threads on different
+ * cores do not contend on one lock, and merges the shards into a single
+ * bulk hand-off to the target log on a background thread.
+ *
+ * A logging thread appends to the shard of the CPU it runs on
+ * (sched_getcpu), behind a lock that is uncontended unless the thread
+ * migrates mid-append. With TIMESTAMP ordering each drain hands the target
+ * the collected entries sorted by Entry::time. Entries are not reordered
+ * across drains. RELAXED keeps shard order and skips the sort, so entries
+ * of a thread that migrated between CPUs may come out of order.
+ */
+class ShardedLog : public ILog {
+public:
+	enum Ordering { TIMESTAMP, RELAXED };
+
+	struct Options {
+		Options() :
+			shards(0),
+			ordering(TIMESTAMP),
+			drainInterval(std::chrono::milliseconds{1}),
+			shardCapacity(16*1024),
+			dropWhenFull(false) { }
+
+		std::size_t shards;	// 0 for one per hardware thread
+		Ordering ordering;
+		std::chrono::microseconds drainInterval;
+		std::size_t shardCapacity;
+		bool dropWhenFull;
+	};
+
+	// Filters on the target's max severity as it is at construction.
+	ShardedLog(ILog& target, const Options& options=Options());
+	~ShardedLog();
+
+	// Drains all shards into the target and flushes it.
+	void flush() override;
+
+protected:
+	void addEntry(const Entry& entry) override;
+	void addEntries(const Entry* entries, std::size_t count) override;
+
+private:
+	struct Shard {
+		std::mutex mutex;
+		std::vector<Entry> entries;
+		char padding[64];	// keep neighbouring shards off each other's cache lines
+	};
+
+	Shard& currentShard();
+	void drain();
+	void drainLoop();
+
+	ILog& _target;
+	const Options _options;
+	std::vector<std::unique_ptr<Shard>> _shards;
+
+	std::mutex _drainMutex;
+	std::vector<Entry> _merged;
+	std::vector<Entry> _spare;
+
+	std::mutex _wakeMutex;
+	std::condition_variable _wake;
+	bool _done;
+	std::thread _merger;
+};
+
+}
+
+#endif /* SHARDEDLOG_H_ */
@@ -0,0 +1,289 @@
+/*
+ * ShmRing.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Georgios Dimitriadis
+ *
+ * Copyright (c) 2026, Georgios Dimitriadis
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include "ShmRing.h"
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <system_error>
+#include <thread>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace std;
+using namespace elf;
+
+struct ShmRing::Header {
+	static const uint64_t MAGIC = 0x31474e4952464c45; // "ELFRING1"
+
+	// Written last by the creator, once the rest of the header is set.
+	atomic<uint64_t> magic;
+	uint64_t capacity;
+	alignas(64) atomic<uint64_t> head;
+	alignas(64) atomic<uint64_t> tail;
+	alignas(64) atomic<uint64_t> dropped;
+};
+
+const uint64_t ShmRing::Header::MAGIC;
+
+namespace {
+
+const uint32_t PADDING = 1;
+
+struct Record {
+	uint32_t size;
+	uint32_t flags;
+};
+
+inline uint64_t recordSize(size_t payload) {
+	return (sizeof(Record) + payload + 7) & ~uint64_t{7};
+}
+
+// How long an opener waits for the creator to set a ring up.
+const chrono::seconds SETUP_TIMEOUT{1};
+
+string shmName(const string& name) {
+	return name.size() && name[0]=='/' ? name : "/" + name;
+}
+
+// Byte locked by each side: open file description locks, so they are held
+// per ShmRing, not per process, and released when the descriptor closes.
+const off_t PRODUCER_LOCK = 0;
+const off_t CONSUMER_LOCK = 1;
+
+void claim(int fd, off_t side, const string& name) {
+	struct flock lock;
+	memset(&lock, 0, sizeof(lock));
+	lock.l_type = F_WRLCK;
+	lock.l_whence = SEEK_SET;
+	lock.l_start = side;
+	lock.l_len = 1;
+	if(::fcntl(fd, F_OFD_SETLK, &lock) != 0) {
+		int error = errno;
+		::close(fd);
+		if(error == EAGAIN || error == EACCES)
+			throw runtime_error("elf::ShmRing: " + name + " already has a " + (side == PRODUCER_LOCK ? "producer" : "consumer"));
+		throw system_error(error, system_category(), "elf::ShmRing: cannot lock " + name);
+	}
+}
+
+}
+
+ShmRing::ShmRing(const string& name, size_t capacity) :
+	_name(name), _lockFd(-1), _header(nullptr), _data(nullptr), _mappedSize(0), _readTail(0) {
+	static_assert(ATOMIC_LLONG_LOCK_FREE == 2, "shared memory ring needs lock-free 64 bit atomics");
+	size_t rounded = 4096;
+	while(rounded < capacity)
+		rounded <<= 1;
+
+	int fd = ::shm_open(shmName(name).c_str(), O_RDWR|O_CREAT|O_EXCL|O_CLOEXEC, 0600);
+	if(fd >= 0) {
+		claim(fd, PRODUCER_LOCK, name);
+		if(::ftruncate(fd, static_cast<off_t>(sizeof(Header) + rounded)) != 0) {
+			int error = errno;
+			::close(fd);
+			throw system_error(error, system_category(), "elf::ShmRing: cannot size " + name);
+		}
+		try {
+			map(fd, rounded);
+		} catch(...) {
+			::close(fd);
+			throw;
+		}
+		_header->capacity = rounded;
+		_header->head.store(0);
+		_header->tail.store(0);
+		_header->dropped.store(0);
+		_header->magic.store(Header::MAGIC, memory_order_release);
+	} else if(errno == EEXIST) {
+		fd = ::shm_open(shmName(name).c_str(), O_RDWR|O_CLOEXEC, 0600);
+		if(fd < 0)
+			throw system_error(errno, system_category(), "elf::ShmRing: cannot open " + name);
+		claim(fd, PRODUCER_LOCK, name);
+		try {
+			attach(fd);
+		} catch(...) {
+			::close(fd);
+			throw;
+		}
+	} else {
+		throw system_error(errno, system_category(), "elf::ShmRing: cannot create " + name);
+	}
+	// Closing the descriptor would release the producer lock.
+	_lockFd = fd;
+	_readTail = _header->tail.load(memory_order_relaxed);
+}
+
+ShmRing::ShmRing(const string& name) :
+	_name(name), _lockFd(-1), _header(nullptr), _data(nullptr), _mappedSize(0), _readTail(0) {
+	int fd = ::shm_open(shmName(name).c_str(), O_RDWR|O_CLOEXEC, 0600);
+	if(fd < 0)
+		throw system_error(errno, system_category(), "elf::ShmRing: cannot open " + name);
+	claim(fd, CONSUMER_LOCK, name);
+	try {
+		attach(fd);
+	} catch(...) {
+		::close(fd);
+		throw;
+	}
+	// Closing the descriptor would release the consumer lock.
+	_lockFd = fd;
+	_readTail = _header->tail.load(memory_order_relaxed);
+}
+
+ShmRing::~ShmRing() {
+	::munmap(_header, _mappedSize);
+	if(_lockFd >= 0)
+		::close(_lockFd);
+}
+
+void ShmRing::unlink(const string& name) {
+	::shm_unlink(shmName(name).c_str());
+}
+
+void ShmRing::attach(int fd) {
+	// The creator sizes the segment first and writes the magic word last.
+	const auto deadline = chrono::steady_clock::now() + SETUP_TIMEOUT;
+	for(;;) {
+		struct stat st;
+		if(::fstat(fd, &st) != 0)
+			throw system_error(errno, system_category(), "elf::ShmRing: cannot open " + _name);
+		if(static_cast<size_t>(st.st_size) > sizeof(Header)) {
+			map(fd, static_cast<size_t>(st.st_size) - sizeof(Header));
+			if(_header->magic.load(memory_order_acquire) == Header::MAGIC)
+				return;
+			::munmap(_header, _mappedSize);
+			_header = nullptr;
+		}
+		if(chrono::steady_clock::now() > deadline)
+			throw runtime_error("elf::ShmRing: not a log ring: " + _name);
+		this_thread::sleep_for(chrono::milliseconds{1});
+	}
+}
+
+void ShmRing::map(int fd, size_t capacity) {
+	_mappedSize = sizeof(Header) + capacity;
+	void* mem = ::mmap(nullptr, _mappedSize, PROT_READ|PROT_WRITE, MAP_SHARED, fd, 0);
+	if(mem == MAP_FAILED)
+		throw system_error(errno, system_category(), "elf::ShmRing: cannot map " + _name);
+
+	_header = static_cast<Header*>(mem);
+	_data = static_cast<char*>(mem) + sizeof(Header);
+	const uint64_t magic = _header->magic.load(memory_order_acquire);
+	if(magic && (magic != Header::MAGIC || _header->capacity != capacity)) {
+		::munmap(mem, _mappedSize);
+		_header = nullptr;
+		throw runtime_error("elf::ShmRing: not a log ring: " + _name);
+	}
+}
+
+size_t ShmRing::capacity() const {
+	return _mappedSize - sizeof(Header);
+}
+
+uint64_t ShmRing::dropped() const {
+	return _header->dropped.load(memory_order_relaxed);
+}
+
+bool ShmRing::push(const char* data, size_t size) {
+	const uint64_t capacity = this->capacity();
+	const uint64_t need = recordSize(size);
+	uint64_t head = _header->head.load(memory_order_relaxed);
+	const uint64_t tail = _header->tail.load(memory_order_acquire);
+	const uint64_t offset = head & (capacity - 1);
+	const uint64_t padding = (capacity - offset < need) ? capacity - offset : 0;
+
+	if(need > capacity/2 || head + padding + need - tail > capacity) {
+		_header->dropped.fetch_add(1, memory_order_relaxed);
+		return false;
+	}
+
+	if(padding) {
+		Record record = {0, PADDING};
+		memcpy(_data + offset, &record, sizeof(record));
+		head += padding;
+	}
+
+	char* at = _data + (head & (capacity - 1));
+	Record record = {static_cast<uint32_t>(size), 0};
+	memcpy(at, &record, sizeof(record));
+	memcpy(at + sizeof(record), data, size);
+	_header->head.store(head + need, memory_order_release);
+	return true;
+}
+
+size_t ShmRing::drain(const consumer_t& consumer) {
+	size_t records = read(consumer);
+	commit();
+	return records;
+}
+
+size_t ShmRing::read(const consumer_t& consumer) {
+	const uint64_t capacity = this->capacity();
+	uint64_t tail = _readTail;
+	const uint64_t head = _header->head.load(memory_order_acquire);
+	size_t records = 0;
+	while(tail < head) {
+		const uint64_t offset = tail & (capacity - 1);
+		Record record;
+		memcpy(&record, _data + offset, sizeof(record));
+		if(record.flags & PADDING) {
+			tail += capacity - offset;
+			continue;
+		}
+		consumer(_data + offset + sizeof(record), record.size);
+		tail += recordSize(record.size);
+		++records;
+	}
+	_readTail = tail;
+	return records;
+}
+
+void ShmRing::commit() {
+	_header->tail.store(_readTail, memory_order_release);
+}
+
+void ShmRing::rewind() {
+	_readTail = _header->tail.load(memory_order_relaxed);
+}
+
+ShmLog::ShmLog(const string& ringName, size_t capacity, Severity maxSeverity) :
+	ILog(maxSeverity),
+	_ring(ringName, capacity) {
+}
+
+void ShmLog::addEntry(const Entry& entry) {
+	_line.clear();
+	format_entry(_line, entry);
+	if(_ring.push(_line.data(), _line.size())) {
+		countBytes(_line.size());
+		countWrites();
+	} else {
+		countDropped();
+	}
+}
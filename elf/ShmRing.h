@@ -0,0 +1,119 @@
+/*
+ * ShmRing.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Georgios Dimitriadis
+ *
+ * Copyright (c) 2026, Georgios Dimitriadis
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef SHMRING_H_
+#define SHMRING_H_
+#include "ILog.h"
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <string>
+
+namespace elf {
+
+/**
+ * Single producer, single consumer byte ring in a POSIX shared memory
+ * segment. The producer and the consumer may live in different processes,
+ * and whatever the producer wrote stays in the segment after it crashed
+ * until a consumer drains it or the segment is unlinked.
+ *
+ * Records are never overwritten: when the ring is full new records are
+ * dropped and counted, so a slow consumer never blocks the producer.
+ *
+ * The producer and the consumer side each hold an exclusive lock on the
+ * segment for as long as they are open, so a second producer or consumer
+ * fails to attach; the locks go away with a crashed process. Consumers
+ * wait for the creator to finish setting the segment up before they map
+ * it.
+ *
+ * drain() frees records as it passes them on. A consumer that must store
+ * them first reads them, stores them and then commits, or rewinds to read
+ * them again when storing failed.
+ */
+class ShmRing {
+public:
+	typedef std::function<void(const char* data, std::size_t size)> consumer_t;
+
+	// Opens the named ring as its producer, creating it with the given
+	// capacity if needed. Throws if another producer has it open.
+	ShmRing(const std::string& name, std::size_t capacity);
+	// Opens an existing ring as its consumer. Throws if another consumer
+	// has it open.
+	explicit ShmRing(const std::string& name);
+	ShmRing(const ShmRing&) = delete;
+	ShmRing& operator=(const ShmRing&) = delete;
+	~ShmRing();
+
+	static void unlink(const std::string& name);
+
+	const std::string& name() const { return _name; }
+	std::size_t capacity() const;
+	std::uint64_t dropped() const;
+
+	bool push(const char* data, std::size_t size);
+	std::size_t drain(const consumer_t& consumer);
+	// Passes the records after those read so far, without freeing them.
+	std::size_t read(const consumer_t& consumer);
+	// Frees the records read so far.
+	void commit();
+	// Makes the records read but not committed readable again.
+	void rewind();
+
+private:
+	struct Header;
+
+	void map(int fd, std::size_t capacity);
+	void attach(int fd);
+
+	std::string _name;
+	int _lockFd;
+	Header* _header;
+	char* _data;
+	std::size_t _mappedSize;
+	std::uint64_t _readTail;
+};
+
+/**
+ * Writes rendered entries into a shared memory ring for an out-of-process
+ * collector, see tools/elf_collector.cpp.
+ */
+class ShmLog : public ILog {
+public:
+	ShmLog(const std::string& ringName, std::size_t capacity=16*1024*1024, Severity maxSeverity=elf::INFO);
+
+	void flush() override { }
+
+protected:
+	void addEntry(const Entry& entry) override;
+
+private:
+	ShmRing _ring;
+	std::string _line;
+};
+
+}
+
+#endif /* SHMRING_H_ */
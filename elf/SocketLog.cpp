@@ -0,0 +1,337 @@
+/*
+ * SocketLog.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Georgios Dimitriadis
+ *
+ * Copyright (c) 2026, Georgios Dimitriadis
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include "SocketLog.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <system_error>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+using namespace std;
+using namespace elf;
+
+/**
+ * A host lookup on a thread of its own: getaddrinfo cannot be interrupted,
+ * so the destructor leaves it behind rather than wait for it.
+ */
+struct SocketLog::Lookup {
+	Lookup() : done(false), abandoned(false), result(nullptr) { }
+
+	mutex guard;
+	condition_variable finished;
+	bool done;
+	bool abandoned;
+	addrinfo* result;
+};
+
+SocketLog::SocketLog(const string& address, Severity maxSeverity, const Options& options) :
+	ILog(maxSeverity),
+	_options(options),
+	_fd(-1),
+	_inflightCounted(0),
+	_connected(false),
+	_dropped(0),
+	_done(false) {
+	if(address.compare(0, 5, "unix:") == 0 && address.size() > 5) {
+		_unixPath = address.substr(5);
+		if(_unixPath.size() >= sizeof(sockaddr_un::sun_path))
+			throw invalid_argument("elf::SocketLog: socket path too long: " + _unixPath);
+	} else if(address.compare(0, 4, "tcp:") == 0 && address.rfind(':') > 4) {
+		string::size_type colon = address.rfind(':');
+		_host = address.substr(4, colon - 4);
+		_port = address.substr(colon + 1);
+	} else {
+		throw invalid_argument("elf::SocketLog: expected unix:<path> or tcp:<host>:<port>, got " + address);
+	}
+	_sender = thread(&SocketLog::sendLoop, this);
+}
+
+SocketLog::~SocketLog() {
+	flush();
+	{
+		lock_guard<mutex> lock(_bufferMutex);
+		_done = true;
+		// Wakes a sender blocked in connect or send, or waiting for a lookup.
+		if(_fd >= 0)
+			::shutdown(_fd, SHUT_RDWR);
+		if(_lookup) {
+			lock_guard<mutex> lookupLock(_lookup->guard);
+			_lookup->abandoned = true;
+			_lookup->finished.notify_all();
+		}
+	}
+	_bufferChanged.notify_all();
+	_sender.join();
+	disconnect();
+	const size_t unsent = _pendingFrames.size() + _inflightFrames.size();
+	if(unsent) {
+		_dropped += unsent;
+		countDropped(unsent);
+	}
+}
+
+void SocketLog::flush() {
+	unique_lock<mutex> lock(_bufferMutex);
+	_bufferChanged.wait_for(lock, _options.flushTimeout, [&] { return _pending.empty() && _inflight.empty(); });
+}
+
+bool SocketLog::isConnected() const {
+	lock_guard<mutex> lock(_bufferMutex);
+	return _connected;
+}
+
+size_t SocketLog::buffered() const {
+	lock_guard<mutex> lock(_bufferMutex);
+	return _pending.size() + _inflight.size();
+}
+
+uint64_t SocketLog::dropped() const {
+	lock_guard<mutex> lock(_bufferMutex);
+	return _dropped;
+}
+
+void SocketLog::addEntry(const Entry& entry) {
+	// The ILog lock serializes addEntry, so _line needs no lock of its own.
+	_line.clear();
+	if(_options.framing == LENGTH_PREFIXED)
+		_line.append(4, '\0');
+	format_entry(_line, entry);
+	if(_options.framing == LENGTH_PREFIXED) {
+		_line.pop_back();
+		const uint32_t length = static_cast<uint32_t>(_line.size() - 4);
+		for(int i=0; i<4; ++i)
+			_line[static_cast<size_t>(i)] = static_cast<char>((length >> (24 - 8*i)) & 0xff);
+	}
+
+	unique_lock<mutex> lock(_bufferMutex);
+	// No amount of draining or dropping makes room for this one.
+	if(_line.size() > _options.bufferBytes) {
+		++_dropped;
+		countDropped();
+		return;
+	}
+	auto room = [&] { return _pending.size() + _inflight.size() + _line.size() <= _options.bufferBytes; };
+	if(!room()) {
+		switch(_options.whenFull) {
+		case BLOCK:
+			_bufferChanged.wait(lock, [&] { return room() || _done; });
+			break;
+		case DROP_OLDEST:
+			while(!room() && !_pendingFrames.empty()) {
+				_pending.erase(0, _pendingFrames.front());
+				_pendingFrames.pop_front();
+				++_dropped;
+				countDropped();
+			}
+			break;
+		case DROP_NEWEST:
+			break;
+		}
+		if(!room()) {
+			++_dropped;
+			countDropped();
+			return;
+		}
+	}
+
+	_pending += _line;
+	_pendingFrames.push_back(_line.size());
+	lock.unlock();
+	_bufferChanged.notify_all();
+}
+
+bool SocketLog::connect() {
+	if(!_unixPath.empty()) {
+		sockaddr_un addr;
+		memset(&addr, 0, sizeof(addr));
+		addr.sun_family = AF_UNIX;
+		strncpy(addr.sun_path, _unixPath.c_str(), sizeof(addr.sun_path) - 1);
+		addrinfo ai;
+		memset(&ai, 0, sizeof(ai));
+		ai.ai_family = AF_UNIX;
+		ai.ai_socktype = SOCK_STREAM;
+		ai.ai_addr = reinterpret_cast<sockaddr*>(&addr);
+		ai.ai_addrlen = sizeof(addr);
+		return connectTo(ai);
+	}
+
+	addrinfo* found = resolve();
+	bool connected = false;
+	for(addrinfo* ai = found; ai && !connected; ai = ai->ai_next) {
+		if(connectTo(*ai)) {
+			int on = 1;
+			::setsockopt(_fd, IPPROTO_TCP, TCP_NODELAY, &on, sizeof(on));
+			connected = true;
+		}
+	}
+	if(found)
+		::freeaddrinfo(found);
+	return connected;
+}
+
+bool SocketLog::connectTo(const addrinfo& address) {
+	int fd = ::socket(address.ai_family, address.ai_socktype|SOCK_CLOEXEC, address.ai_protocol);
+	if(fd < 0)
+		return false;
+	// Linux applies the send timeout to connect as well.
+	timeval timeout;
+	timeout.tv_sec = static_cast<time_t>(_options.ioTimeout.count() / 1000);
+	timeout.tv_usec = static_cast<suseconds_t>(_options.ioTimeout.count() % 1000 * 1000);
+	::setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+	{
+		lock_guard<mutex> lock(_bufferMutex);
+		if(_done) {
+			::close(fd);
+			return false;
+		}
+		_fd = fd;
+	}
+	if(::connect(fd, address.ai_addr, address.ai_addrlen) == 0)
+		return true;
+	lock_guard<mutex> lock(_bufferMutex);
+	disconnect();
+	return false;
+}
+
+addrinfo* SocketLog::resolve() {
+	shared_ptr<Lookup> lookup = make_shared<Lookup>();
+	{
+		lock_guard<mutex> lock(_bufferMutex);
+		if(_done)
+			return nullptr;
+		_lookup = lookup;
+	}
+	const string host = _host;
+	const string port = _port;
+	try {
+		thread([lookup, host, port] {
+			addrinfo hints;
+			memset(&hints, 0, sizeof(hints));
+			hints.ai_family = AF_UNSPEC;
+			hints.ai_socktype = SOCK_STREAM;
+			addrinfo* found = nullptr;
+			if(::getaddrinfo(host.c_str(), port.c_str(), &hints, &found) != 0)
+				found = nullptr;
+			lock_guard<mutex> lock(lookup->guard);
+			lookup->done = true;
+			if(lookup->abandoned) {
+				if(found)
+					::freeaddrinfo(found);
+			} else {
+				lookup->result = found;
+			}
+			lookup->finished.notify_all();
+		}).detach();
+	} catch(const system_error&) {
+		return nullptr;
+	}
+
+	unique_lock<mutex> lock(lookup->guard);
+	lookup->finished.wait(lock, [&] { return lookup->done || lookup->abandoned; });
+	// A lookup still running frees its own result.
+	lookup->abandoned = true;
+	addrinfo* found = lookup->result;
+	lookup->result = nullptr;
+	return found;
+}
+
+void SocketLog::disconnect() {
+	if(_fd >= 0)
+		::close(_fd);
+	_fd = -1;
+}
+
+void SocketLog::sendLoop() {
+	chrono::milliseconds backoff = _options.reconnectDelay;
+	unique_lock<mutex> lock(_bufferMutex);
+	while(true) {
+		_bufferChanged.wait(lock, [&] { return _done || !_pending.empty() || !_inflight.empty(); });
+		if(_done)
+			return;
+
+		if(_fd < 0) {
+			lock.unlock();
+			bool connected = connect();
+			lock.lock();
+			_connected = connected;
+			if(!connected) {
+				_bufferChanged.wait_for(lock, backoff, [&] { return _done; });
+				backoff = min(backoff * 2, _options.maxReconnectDelay);
+				continue;
+			}
+			backoff = _options.reconnectDelay;
+		}
+
+		if(_inflight.empty()) {
+			_inflight.swap(_pending);
+			_inflightFrames.swap(_pendingFrames);
+		}
+		lock.unlock();
+
+		size_t sent = 0;
+		while(sent < _inflight.size()) {
+			ssize_t n = ::send(_fd, _inflight.data() + sent, _inflight.size() - sent, MSG_NOSIGNAL);
+			if(n < 0 && errno == EINTR)
+				continue;
+			if(n <= 0)
+				break;
+			sent += static_cast<size_t>(n);
+			// A frame resent after a reconnect was partly counted already.
+			if(sent > _inflightCounted) {
+				countBytes(sent - _inflightCounted);
+				_inflightCounted = sent;
+			}
+			countWrites();
+		}
+
+		lock.lock();
+		if(sent < _inflight.size()) {
+			// Keep the first frame that did not make it whole, for the next connection.
+			size_t complete = 0;
+			while(!_inflightFrames.empty() && complete + _inflightFrames.front() <= sent) {
+				complete += _inflightFrames.front();
+				_inflightFrames.pop_front();
+			}
+			_inflight.erase(0, complete);
+			_inflightCounted = sent - complete;
+			disconnect();
+			_connected = false;
+		} else {
+			_inflight.clear();
+			_inflightFrames.clear();
+			_inflightCounted = 0;
+		}
+		_bufferChanged.notify_all();
+	}
+}
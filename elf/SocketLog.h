@@ -0,0 +1,144 @@
+/*
+ * SocketLog.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Georgios Dimitriadis
+ *
+ * Copyright (c) 2026, Georgios Dimitriadis
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef SOCKETLOG_H_
+#define SOCKETLOG_H_
+#include "ILog.h"
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+struct addrinfo;
+
+namespace elf {
+
+/**
+ * Forwards entries to a log collector over a Unix or TCP stream socket.
+ *
+ * The address is "unix:<path>" or "tcp:<host>:<port>". Each entry is one
+ * frame: the format_entry line, or with LENGTH_PREFIXED the same line
+ * without its newline behind a 4 byte big endian length.
+ *
+ * Logging threads only append frames to a buffer. A sender thread writes
+ * everything buffered since its last write in one send(2), so writes
+ * coalesce by themselves under load. While the collector is unreachable
+ * the sender reconnects with exponential backoff and the buffer keeps up
+ * to bufferBytes of frames. A frame cut short by a broken connection is
+ * sent again whole on the next one.
+ *
+ * When the buffer is full, whenFull decides: BLOCK makes the logging
+ * thread wait for room, DROP_NEWEST drops the new entry and DROP_OLDEST
+ * drops buffered frames not yet handed to the socket. Drops are counted in
+ * the stats and in dropped().
+ *
+ * A connect or send the collector does not answer gives up after
+ * ioTimeout. The destructor waits up to flushTimeout, then cuts off the
+ * sender wherever it is and counts the frames still buffered as dropped.
+ */
+class SocketLog : public ILog {
+public:
+	enum Framing { NEWLINE, LENGTH_PREFIXED };
+	enum Backpressure { BLOCK, DROP_NEWEST, DROP_OLDEST };
+
+	struct Options {
+		Options() :
+			framing(NEWLINE),
+			bufferBytes(4*1024*1024),
+			whenFull(DROP_NEWEST),
+			reconnectDelay(std::chrono::milliseconds{50}),
+			maxReconnectDelay(std::chrono::seconds{5}),
+			flushTimeout(std::chrono::seconds{1}),
+			ioTimeout(std::chrono::seconds{5}) { }
+
+		Framing framing;
+		std::size_t bufferBytes;
+		Backpressure whenFull;
+		std::chrono::milliseconds reconnectDelay;
+		std::chrono::milliseconds maxReconnectDelay;
+		// How long flush() and the destructor wait for the buffer to drain.
+		std::chrono::milliseconds flushTimeout;
+		// How long one connect(2) or send(2) may block before the
+		// connection counts as broken.
+		std::chrono::milliseconds ioTimeout;
+	};
+
+	// Throws std::invalid_argument for a malformed address. Does not wait
+	// for the first connection.
+	SocketLog(const std::string& address, Severity maxSeverity=elf::INFO, const Options& options=Options());
+	~SocketLog();
+
+	// Waits up to flushTimeout until everything buffered has been sent.
+	void flush() override;
+
+	bool isConnected() const;
+	std::size_t buffered() const;
+	std::uint64_t dropped() const;
+
+protected:
+	void addEntry(const Entry& entry) override;
+
+private:
+	typedef std::chrono::steady_clock clock_t;
+	struct Lookup;
+
+	bool connect();
+	bool connectTo(const addrinfo& address);
+	addrinfo* resolve();
+	void disconnect();
+	void sendLoop();
+
+	const Options _options;
+	std::string _unixPath;
+	std::string _host;
+	std::string _port;
+	// Set by the sender under _bufferMutex, so the destructor can shut it down.
+	int _fd;
+	// The sender's host lookup, for the destructor to abandon.
+	std::shared_ptr<Lookup> _lookup;
+	std::string _line;
+
+	mutable std::mutex _bufferMutex;
+	std::condition_variable _bufferChanged;
+	// Frames not yet taken by the sender, and those it is sending.
+	std::string _pending;
+	std::deque<std::size_t> _pendingFrames;
+	std::string _inflight;
+	std::deque<std::size_t> _inflightFrames;
+	// Bytes of _inflight already counted in the stats; sender only.
+	std::size_t _inflightCounted;
+	bool _connected;
+	std::uint64_t _dropped;
+	bool _done;
+	std::thread _sender;
+};
+
+}
+
+#endif /* SOCKETLOG_H_ */
@@ -0,0 +1,104 @@
+/*
+ * Span.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Georgios Dimitriadis
+ *
+ * Copyright (c) 2026, Georgios Dimitriadis
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include "Span.h"
+#include <algorithm>
+#include <vector>
+#include <unistd.h>
+#include <sys/syscall.h>
+
+using namespace std;
+using namespace elf;
+
+namespace {
+
+struct SpanBuffer {
+	// Consecutive spans going to the same logs.
+	struct Run {
+		vector<ILog*> logs;
+		size_t end;
+	};
+
+	SpanBuffer() :
+		thread(static_cast<uint64_t>(syscall(SYS_gettid))),
+		depth(0) { }
+
+	void add(const list<ILog*>& targets, Entry&& entry) {
+		if(runs.empty() || targets.size() != runs.back().logs.size()
+				|| !equal(targets.begin(), targets.end(), runs.back().logs.begin()))
+			runs.push_back(Run{vector<ILog*>(targets.begin(), targets.end()), 0});
+		entries.push_back(move(entry));
+		runs.back().end = entries.size();
+	}
+
+	void dispatch() {
+		size_t begin = 0;
+		for(const auto& run : runs) {
+			for(auto log : run.logs)
+				log->handle(entries.data() + begin, run.end - begin);
+			begin = run.end;
+		}
+		entries.clear();
+		runs.clear();
+	}
+
+	const uint64_t thread;
+	unsigned depth;
+	vector<Entry> entries;
+	vector<Run> runs;
+};
+
+thread_local SpanBuffer spans;
+
+}
+
+Span::Span(Logger& logger, const string& name, Severity severity) :
+	_logger(logger.isEnabled(severity) ? &logger : nullptr),
+	_severity(severity) {
+	if(!_logger)
+		return;
+	_name = name;
+	++spans.depth;
+	_begin = logtime::clock::now();
+}
+
+Span::~Span() {
+	if(!_logger)
+		return;
+
+	logtime end = logtime::clock::now();
+	Entry entry;
+	entry.severity = _severity;
+	entry.time = _begin;
+	entry.facility = _logger->getFacility();
+	entry.message = to_logstring(_name) + L" took "
+			+ to_logstring(chrono::duration_cast<chrono::microseconds>(end - _begin).count()) + L" us";
+	entry.set<SpanTag>(SpanInfo{move(_name), end, spans.thread});
+	spans.add(_logger->getLogs(), move(entry));
+
+	if(--spans.depth == 0 || spans.entries.size() >= bufferSize)
+		spans.dispatch();
+}
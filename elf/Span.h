@@ -0,0 +1,83 @@
+/*
+ * Span.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Georgios Dimitriadis
+ *
+ * Copyright (c) 2026, Georgios Dimitriadis
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef SPAN_H_
+#define SPAN_H_
+#include "Logger.h"
+#include <cstdint>
+#include <string>
+
+namespace elf {
+
+/**
+ * Custom data attached to the entries of finished spans, under the SpanTag
+ * key. The entry's time is the start of the span and its message reads
+ * "<name> took <n> us", so text sinks still show something useful.
+ */
+struct SpanTag { };
+
+struct SpanInfo {
+	std::string name;
+	logtime end;
+	std::uint64_t thread;
+};
+
+/**
+ * Times a scope and logs it as a single entry when the scope ends.
+ *
+ * Finished spans go to a per-thread buffer instead of straight to the
+ * logs; the buffer is handed over in one ILog::handle call per log when
+ * the outermost span on the thread ends or the buffer holds bufferSize
+ * spans. Nested spans therefore cost one clock read and a buffer append
+ * each, and the sinks see them in order of completion.
+ *
+ * A span whose severity is disabled for the logger's facility records
+ * nothing. The logger's logs must outlive the thread's outermost span.
+ */
+class Span {
+public:
+	static const std::size_t bufferSize = 256;
+
+	Span(Logger& logger, const std::string& name, Severity severity=elf::DEBUG);
+	~Span();
+
+	Span(const Span&) = delete;
+	Span& operator=(const Span&) = delete;
+
+private:
+	Logger* _logger;
+	Severity _severity;
+	std::string _name;
+	logtime _begin;
+};
+
+}
+
+#define ELF_SPAN_CONCAT2(a, b) a##b
+#define ELF_SPAN_CONCAT(a, b) ELF_SPAN_CONCAT2(a, b)
+#define ELF_SPAN(logger, name) elf::Span ELF_SPAN_CONCAT(_elfSpan, __LINE__)(logger, name)
+
+#endif /* SPAN_H_ */
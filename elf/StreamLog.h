@@ -39,19 +39,17 @@ public:
 
 protected:
 	void addEntry(const Entry& entry) override {
-		typedef std::chrono::seconds secs_t;
-		typedef std::chrono::milliseconds millis_t;
-		int64_t secs = std::chrono::duration_cast<secs_t>(entry.time.time_since_epoch()).count();
-		int64_t millis = std::chrono::duration_cast<millis_t>(entry.time.time_since_epoch()).count() - 1000*secs;
-		_os << "|" << to_string(entry.severity) <<
-			   "|" << secs << "." << millis <<
-			   "|" << entry.facility <<
-			   "|" << entry.message <<
-			   std::endl;
+		_line.clear();
+		format_entry(_line, entry);
+		_os.write(_line.data(), static_cast<std::streamsize>(_line.size()));
+		_os.flush();
+		countBytes(_line.size());
+		countWrites();
 	}
 
 private:
 	std::ostream& _os;
+	std::string _line;
 };
 
 }
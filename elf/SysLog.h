@@ -45,18 +45,17 @@ protected:
 	void addEntry(const Entry& entry) override {
 		typedef std::chrono::seconds secs_t;
 		typedef std::chrono::milliseconds millis_t;
-		int64_t secs = std::chrono::duration_cast<secs_t>(entry.time.time_since_epoch()).count();
-		int64_t millis = std::chrono::duration_cast<millis_t>(entry.time.time_since_epoch()).count() - 1000*secs;
+		long long secs = std::chrono::duration_cast<secs_t>(entry.time.time_since_epoch()).count();
+		long long millis = std::chrono::duration_cast<millis_t>(entry.time.time_since_epoch()).count() - 1000*secs;
 
-		auto facility_priority = LOG_MAKEPRI(LOG_USER, LOG_ERR);
 		syslog(
 				LOG_MAKEPRI(LOG_USER, sev2pri(entry.severity)),
-				"|%lu.%06lu|%s|%s|%s",
+				"|%lld.%03lld|%s|%s|%s",
 				secs,
 				millis,
 				entry.facility.c_str(),
 				to_string(entry.severity).c_str(),
-				entry.message.c_str()
+				to_utf8(entry.message).c_str()
 				);
 	}
 
@@ -71,6 +70,7 @@ protected:
 		case INFO:		return LOG_INFO;
 		case DEBUG:		return LOG_DEBUG;
 		}
+		return LOG_DEBUG;
 	}
 
 };
@@ -0,0 +1,135 @@
+/*
+ * TraceEventLog.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Georgios Dimitriadis
+ *
+ * Copyright (c) 2026, Georgios Dimitriadis
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include "TraceEventLog.h"
+#include "Span.h"
+#include <cerrno>
+#include <cinttypes>
+#include <system_error>
+#include <unistd.h>
+#include <sys/syscall.h>
+
+using namespace std;
+using namespace elf;
+
+namespace {
+
+void append_json_string(string& out, const string& str) {
+	out += '"';
+	for(char c : str) {
+		switch(c) {
+		case '"':	out += "\\\""; break;
+		case '\\':	out += "\\\\"; break;
+		case '\n':	out += "\\n"; break;
+		case '\r':	out += "\\r"; break;
+		case '\t':	out += "\\t"; break;
+		default:
+			if(static_cast<unsigned char>(c) < 0x20) {
+				char escaped[8];
+				snprintf(escaped, sizeof(escaped), "\\u%04x", static_cast<unsigned>(c));
+				out += escaped;
+			} else {
+				out += c;
+			}
+		}
+	}
+	out += '"';
+}
+
+// Trace event timestamps are microseconds; keep the nanoseconds as decimals.
+void append_micros(string& out, int64_t nanos) {
+	char micros[32];
+	snprintf(micros, sizeof(micros), "%" PRId64 ".%03" PRId64, nanos / 1000, nanos % 1000);
+	out += micros;
+}
+
+int64_t since_epoch(const logtime& time) {
+	return chrono::duration_cast<chrono::nanoseconds>(time.time_since_epoch()).count();
+}
+
+}
+
+TraceEventLog::TraceEventLog(const string& path, Severity maxSeverity, size_t bufferBytes) :
+	ILog(maxSeverity),
+	_file(fopen(path.c_str(), "w")),
+	_bufferBytes(bufferBytes),
+	_pid(static_cast<long>(getpid())),
+	_buffer("["),
+	_first(true) {
+	if(!_file)
+		throw system_error(errno, system_category(), "elf::TraceEventLog: cannot open " + path);
+	_buffer.reserve(bufferBytes + 1024);
+}
+
+TraceEventLog::~TraceEventLog() {
+	_buffer += "\n]\n";
+	write();
+	fclose(_file);
+}
+
+void TraceEventLog::flush() {
+	lock_guard<mutex> lock(getMutex());
+	write();
+	fflush(_file);
+}
+
+void TraceEventLog::addEntry(const Entry& entry) {
+	_buffer += _first ? "\n" : ",\n";
+	_first = false;
+
+	SpanInfo span;
+	const bool isSpan = entry.get<SpanTag>(span);
+	const int64_t begin = since_epoch(entry.time);
+
+	_buffer += "{\"name\":";
+	append_json_string(_buffer, isSpan ? span.name : to_utf8(entry.message));
+	_buffer += ",\"cat\":";
+	append_json_string(_buffer, entry.facility);
+	if(isSpan) {
+		_buffer += ",\"ph\":\"X\",\"ts\":";
+		append_micros(_buffer, begin);
+		_buffer += ",\"dur\":";
+		append_micros(_buffer, since_epoch(span.end) - begin);
+	} else {
+		_buffer += ",\"ph\":\"i\",\"s\":\"t\",\"ts\":";
+		append_micros(_buffer, begin);
+	}
+	_buffer += ",\"pid\":" + std::to_string(_pid);
+	_buffer += ",\"tid\":" + std::to_string(isSpan ? span.thread : static_cast<uint64_t>(syscall(SYS_gettid)));
+	_buffer += ",\"args\":{\"severity\":\"" + to_string(entry.severity) + "\"}}";
+
+	if(_buffer.size() >= _bufferBytes)
+		write();
+}
+
+void TraceEventLog::write() {
+	if(_buffer.empty())
+		return;
+	size_t written = fwrite(_buffer.data(), 1, _buffer.size(), _file);
+	countBytes(written);
+	countWrites();
+	_buffer.clear();
+}
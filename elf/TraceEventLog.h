@@ -0,0 +1,72 @@
+/*
+ * TraceEventLog.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Georgios Dimitriadis
+ *
+ * Copyright (c) 2026, Georgios Dimitriadis
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef TRACEEVENTLOG_H_
+#define TRACEEVENTLOG_H_
+#include "ILog.h"
+#include <cstdio>
+#include <string>
+
+namespace elf {
+
+/**
+ * Writes entries as Chrome trace events (the JSON array format), which
+ * chrome://tracing and ui.perfetto.dev load as a timeline.
+ *
+ * Entries from a Span become complete events ("ph":"X") on the thread
+ * that ran them, categorised by facility. Other entries become thread
+ * scoped instant events carrying their severity, so ordinary log lines
+ * show up as markers between the spans. Entries not from a span are put
+ * on the thread of whoever logs them, which with a queueing front like
+ * AsyncLog is the delivering thread.
+ *
+ * Events are buffered and written once the buffer passes bufferBytes and
+ * on flush(). The closing bracket is written on destruction; both viewers
+ * also accept a file cut short without it.
+ */
+class TraceEventLog : public ILog {
+public:
+	TraceEventLog(const std::string& path, Severity maxSeverity=elf::DEBUG, std::size_t bufferBytes=64*1024);
+	~TraceEventLog();
+
+	void flush() override;
+
+protected:
+	void addEntry(const Entry& entry) override;
+
+private:
+	void write();
+
+	std::FILE* _file;
+	const std::size_t _bufferBytes;
+	const long _pid;
+	std::string _buffer;
+	bool _first;
+};
+
+}
+
+#endif /* TRACEEVENTLOG_H_ */
@@ -0,0 +1,246 @@
+/*
+ * bench_Logger.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Georgios Dimitriadis
+ *
+ * Copyright (c) 2026, Georgios Dimitriadis
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+/*
+ * Micro- and macro-benchmarks of Logger and the sinks.
+ *
+ *   bench_Logger [calls] [max-threads]
+ *
+ * Prints one CSV row per benchmark: wall-clock time divided by the calls
+ * made per thread in a run without per-call timing, heap allocations per
+ * call counted by replacing the global operator new, and latency
+ * percentiles from a second run that times every call (so those include
+ * the cost of reading the clock).
+ */
+#include "../Logger.h"
+#include "../StreamLog.h"
+#include "../FileLog.h"
+#include "../AsyncLog.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <new>
+#include <string>
+#include <thread>
+#include <vector>
+#include <unistd.h>
+
+using namespace std;
+using namespace elf;
+
+static atomic<uint64_t> allocations(0);
+
+// Kept out of line so the compiler does not pair the malloc/free inside
+// with the new/delete expressions of the code being measured.
+__attribute__((noinline)) void* operator new(size_t size) {
+	allocations.fetch_add(1, memory_order_relaxed);
+	if(void* p = malloc(size ? size : 1))
+		return p;
+	throw bad_alloc();
+}
+
+__attribute__((noinline)) void operator delete(void* p) noexcept {
+	free(p);
+}
+
+__attribute__((noinline)) void operator delete(void* p, size_t) noexcept {
+	free(p);
+}
+
+namespace {
+
+struct NullLog : public ILog {
+	NullLog() : ILog(DEBUG) { }
+	void flush() override { }
+protected:
+	void addEntry(const Entry&) override { }
+};
+
+struct result {
+	double nsPerCall;
+	double allocsPerCall;
+	uint64_t p50, p99, p999;
+};
+
+void report(const string& name, unsigned threads, uint64_t calls, const result& r) {
+	cout << name << "," << threads << "," << calls << ","
+		 << r.nsPerCall << "," << r.allocsPerCall << ","
+		 << r.p50 << "," << r.p99 << "," << r.p999 << endl;
+}
+
+/**
+ * Runs call() calls times on each of threads threads, first for throughput
+ * and allocations, then timing every call for the percentiles.
+ */
+template<typename Call>
+result measure(unsigned threads, uint64_t calls, Call call) {
+	result r;
+	vector<vector<uint32_t>> samples(threads);
+	for(auto& s : samples)
+		s.reserve(calls);
+
+	for(int pass=0; pass<2; ++pass) {
+		atomic<unsigned> ready(0);
+		atomic<bool> go(false);
+		vector<thread> workers;
+		for(unsigned t=0; t<threads; ++t) {
+			workers.emplace_back([&, t, pass] {
+				++ready;
+				while(!go)
+					this_thread::yield();
+				if(pass == 0) {
+					for(uint64_t i=0; i<calls; ++i)
+						call(t, i);
+				} else {
+					for(uint64_t i=0; i<calls; ++i) {
+						auto begin = chrono::steady_clock::now();
+						call(t, i);
+						auto end = chrono::steady_clock::now();
+						samples[t].push_back(static_cast<uint32_t>(min<int64_t>(
+								chrono::duration_cast<chrono::nanoseconds>(end - begin).count(), UINT32_MAX)));
+					}
+				}
+			});
+		}
+		while(ready < threads)
+			this_thread::yield();
+
+		uint64_t allocsBefore = allocations.load();
+		auto begin = chrono::steady_clock::now();
+		go = true;
+		for(auto& worker : workers)
+			worker.join();
+		auto end = chrono::steady_clock::now();
+
+		if(pass == 0) {
+			// Thread start-up allocations are made before the clock starts.
+			r.allocsPerCall = static_cast<double>(allocations.load() - allocsBefore) / static_cast<double>(threads * calls);
+			r.nsPerCall = static_cast<double>(chrono::duration_cast<chrono::nanoseconds>(end - begin).count()) /
+					static_cast<double>(calls);
+		}
+	}
+
+	vector<uint32_t> all;
+	for(const auto& s : samples)
+		all.insert(all.end(), s.begin(), s.end());
+	sort(all.begin(), all.end());
+	auto at = [&](double q) { return static_cast<uint64_t>(all[min(all.size() - 1, static_cast<size_t>(q * static_cast<double>(all.size())))]); };
+	r.p50 = at(0.5);
+	r.p99 = at(0.99);
+	r.p999 = at(0.999);
+	return r;
+}
+
+void bench_sink(const string& name, ILog& sink, uint64_t calls) {
+	Logger logger(sink, "bench.sink");
+	report(name, 1, calls, measure(1, calls, [&](unsigned, uint64_t i) {
+		logger << "request " << i << " served in " << 42 << " ms" << end_entry;
+	}));
+	sink.flush();
+}
+
+}
+
+int main(int argc, char* argv[]) {
+	const uint64_t calls = argc > 1 ? static_cast<uint64_t>(atoll(argv[1])) : 100000;
+	const unsigned maxThreads = argc > 2 ? static_cast<unsigned>(atoi(argv[2])) : max(1u, thread::hardware_concurrency());
+	const string path = "/tmp/elf_bench_" + to_string(::getpid()) + ".log";
+
+	cout << "benchmark,threads,calls_per_thread,ns_per_call,allocs_per_call,p50_ns,p99_ns,p999_ns" << endl;
+
+	{
+		NullLog sink;
+		Logger logger(sink, "bench.logger", INFO);
+
+		report("chain_str_int", 1, calls, measure(1, calls, [&](unsigned, uint64_t i) {
+			logger << "request " << i << " served in " << 42 << " ms" << end_entry;
+		}));
+		report("chain_mixed_with_location", 1, calls, measure(1, calls, [&](unsigned, uint64_t i) {
+			logger << WARNING << ELF_LOC << "value " << 3.14159 << " for key " << string("session") << " #" << i << end_entry;
+		}));
+		report("end_entry_only", 1, calls, measure(1, calls, [&](unsigned, uint64_t) {
+			logger << end_entry;
+		}));
+
+		sink.setMaxSeverity(INFO);
+		report("filtered_by_sink", 1, calls, measure(1, calls, [&](unsigned, uint64_t i) {
+			logger << DEBUG << "request " << i << end_entry;
+		}));
+		FacilityTree::instance().setThreshold("bench.logger", INFO);
+		report("filtered_by_facility", 1, calls, measure(1, calls, [&](unsigned, uint64_t i) {
+			logger << DEBUG << "request " << i << end_entry;
+		}));
+		report("is_enabled_check", 1, calls, measure(1, calls, [&](unsigned, uint64_t i) {
+			if(logger.isEnabled(DEBUG))
+				logger << DEBUG << "request " << i << end_entry;
+		}));
+		FacilityTree::instance().clearThreshold("bench.logger");
+	}
+
+	for(unsigned threads=1; threads<=maxThreads; threads*=2) {
+		NullLog sink;
+		Logger shared(sink, "bench.contention");
+		report("shared_logger", threads, calls, measure(threads, calls, [&](unsigned, uint64_t i) {
+			shared << "request " << i << end_entry;
+		}));
+		report("logger_per_thread", threads, calls, [&] {
+			vector<Logger> loggers;
+			for(unsigned t=0; t<threads; ++t)
+				loggers.push_back(shared.duplicate("bench.contention"));
+			return measure(threads, calls, [&](unsigned t, uint64_t i) {
+				loggers[t] << "request " << i << end_entry;
+			});
+		}());
+	}
+
+	{
+		ofstream devnull("/dev/null");
+		StreamLog sink(devnull);
+		bench_sink("stream_log_dev_null", sink, calls);
+	}
+	{
+		ofstream file(path);
+		StreamLog sink(file);
+		bench_sink("stream_log_file", sink, calls);
+	}
+	::remove(path.c_str());
+	{
+		FileLog sink(path);
+		bench_sink("file_log", sink, calls);
+	}
+	::remove(path.c_str());
+	{
+		FileLog file(path);
+		AsyncLog sink(file);
+		bench_sink("async_file_log", sink, calls);
+	}
+	::remove(path.c_str());
+	return 0;
+}
@@ -0,0 +1,118 @@
+/*
+ * bench_ShardedLog.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Georgios Dimitriadis
+ *
+ * Copyright (c) 2026, Georgios Dimitriadis
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+/*
+ * Throughput of ILog::handle from 1 to N threads, straight into a sink
+ * and through a ShardedLog in front of the same sink.
+ *
+ *   bench_ShardedLog [max-threads] [entries-per-thread]
+ *
+ * Prints one CSV row per configuration.
+ */
+#include "../ShardedLog.h"
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+using namespace std;
+using namespace elf;
+
+namespace {
+
+// Stands in for a sink that does a little work per entry under its lock.
+struct NullLog : public ILog {
+	NullLog() : ILog(DEBUG), bytes(0) { }
+	void flush() override { }
+	size_t bytes;
+protected:
+	void addEntry(const Entry& entry) override { bytes += entry.message.size(); }
+};
+
+double run(ILog& log, unsigned threads, unsigned entries) {
+	atomic<unsigned> ready(0);
+	atomic<bool> go(false);
+	vector<thread> writers;
+	for(unsigned t=0; t<threads; ++t) {
+		writers.emplace_back([&] {
+			Entry entry;
+			entry.severity = INFO;
+			entry.facility = "bench";
+			entry.message = L"a typical log message of moderate length";
+			++ready;
+			while(!go)
+				this_thread::yield();
+			for(unsigned i=0; i<entries; ++i) {
+				entry.time = chrono::high_resolution_clock::now();
+				log.handle(entry);
+			}
+		});
+	}
+	while(ready < threads)
+		this_thread::yield();
+
+	auto begin = chrono::steady_clock::now();
+	go = true;
+	for(auto& writer : writers)
+		writer.join();
+	log.flush();
+	chrono::duration<double> elapsed = chrono::steady_clock::now() - begin;
+	return threads * static_cast<double>(entries) / elapsed.count();
+}
+
+}
+
+int main(int argc, char* argv[]) {
+	unsigned maxThreads = argc > 1 ? static_cast<unsigned>(atoi(argv[1])) : max(1u, thread::hardware_concurrency());
+	unsigned entries = argc > 2 ? static_cast<unsigned>(atoi(argv[2])) : 200000;
+
+	cout << "sink,threads,entries_per_sec,per_thread" << endl;
+	for(unsigned threads=1; threads<=maxThreads; threads*=2) {
+		{
+			NullLog sink;
+			double rate = run(sink, threads, entries);
+			cout << "direct," << threads << "," << static_cast<uint64_t>(rate) << "," << static_cast<uint64_t>(rate/threads) << endl;
+		}
+		{
+			NullLog sink;
+			ShardedLog::Options options;
+			options.ordering = ShardedLog::RELAXED;
+			ShardedLog sharded(sink, options);
+			double rate = run(sharded, threads, entries);
+			cout << "sharded_relaxed," << threads << "," << static_cast<uint64_t>(rate) << "," << static_cast<uint64_t>(rate/threads) << endl;
+		}
+		{
+			NullLog sink;
+			ShardedLog sharded(sink);
+			double rate = run(sharded, threads, entries);
+			cout << "sharded_timestamp," << threads << "," << static_cast<uint64_t>(rate) << "," << static_cast<uint64_t>(rate/threads) << endl;
+		}
+	}
+	return 0;
+}
@@ -0,0 +1,183 @@
+/*
+ * test_AsyncLog.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Georgios Dimitriadis
+ *
+ * Copyright (c) 2026, Georgios Dimitriadis
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <boost/test/unit_test.hpp>
+#include "../Logger.h"
+#include "../AsyncLog.h"
+#include <atomic>
+#include <condition_variable>
+#include <thread>
+
+using namespace std;
+using namespace elf;
+
+BOOST_AUTO_TEST_SUITE(test_async_log)
+
+struct SlowLog : public ILog {
+	SlowLog() : ILog(DEBUG), delay(0) { }
+
+	vector<Entry> written;
+	vector<size_t> flushedAt;
+	chrono::microseconds delay;
+
+	void flush() override { flushedAt.push_back(written.size()); }
+protected:
+	void addEntry(const Entry& entry) override {
+		this_thread::sleep_for(delay);
+		written.push_back(entry);
+	}
+};
+
+BOOST_AUTO_TEST_CASE(delivers_everything_in_order) {
+	SlowLog target;
+	{
+		AsyncLog async(target);
+		Logger logger(async, "ASYNC_TEST");
+		for(int i=0; i<1000; ++i)
+			logger << "entry " << i << end_entry;
+	}
+
+	BOOST_REQUIRE_EQUAL(target.written.size(), 1000u);
+	for(int i=0; i<1000; ++i)
+		BOOST_CHECK(target.written[i].message == L"entry " + to_wstring(i));
+}
+
+BOOST_AUTO_TEST_CASE(urgent_entry_overtakes_backlog) {
+	SlowLog target;
+	target.delay = chrono::microseconds{200};
+	AsyncLog::Options options;
+	options.chunkSize = 4;
+	AsyncLog async(target, options);
+	Logger logger(async, "ASYNC_TEST", INFO);
+
+	for(int i=0; i<500; ++i)
+		logger << "backlog " << i << end_entry;
+	logger << ALERT << "first alert" << end_entry;
+	logger << EMERGENCY << "second alert" << end_entry;
+	async.flush();
+
+	BOOST_REQUIRE_EQUAL(target.written.size(), 502u);
+	size_t first = 0, second = 0;
+	for(size_t i=0; i<target.written.size(); ++i) {
+		if(target.written[i].message == L"first alert") first = i;
+		if(target.written[i].message == L"second alert") second = i;
+	}
+	BOOST_CHECK(first < 100);
+	BOOST_CHECK_EQUAL(second, first + 1);
+	BOOST_REQUIRE(!target.flushedAt.empty());
+	BOOST_CHECK_EQUAL(target.flushedAt.front(), second + 1);
+
+	int expected = 0;
+	for(const auto& entry : target.written) {
+		if(entry.severity == INFO)
+			BOOST_CHECK(entry.message == L"backlog " + to_wstring(expected++));
+	}
+	BOOST_CHECK_EQUAL(expected, 500);
+}
+
+// Holds up ordinary entries until released.
+struct StalledLog : public ILog {
+	StalledLog() : ILog(DEBUG), released(false) { }
+
+	mutex gate;
+	condition_variable opened;
+	bool released;
+	vector<Entry> written;
+
+	void release() {
+		lock_guard<mutex> lock(gate);
+		released = true;
+		opened.notify_all();
+	}
+
+	void flush() override { }
+protected:
+	void addEntry(const Entry& entry) override {
+		unique_lock<mutex> lock(gate);
+		if(entry.severity > ALERT)
+			opened.wait(lock, [&] { return released; });
+		written.push_back(entry);
+	}
+};
+
+BOOST_AUTO_TEST_CASE(urgent_entry_passes_full_lane) {
+	StalledLog target;
+	AsyncLog::Options options;
+	options.capacity = 1;
+	options.chunkSize = 1;
+	AsyncLog async(target, options);
+
+	// The worker stalls on the first entry, the second fills the lane and
+	// the third leaves its thread waiting for room.
+	thread ordinary([&] {
+		Logger logger(async, "ASYNC_TEST", INFO);
+		for(int i=0; i<3; ++i)
+			logger << "ordinary " << i << end_entry;
+	});
+	this_thread::sleep_for(chrono::milliseconds{50});
+
+	atomic<bool> logged(false);
+	thread urgent([&] {
+		Logger logger(async, "ASYNC_TEST", INFO);
+		logger << ALERT << "alert" << end_entry;
+		logged = true;
+	});
+	for(int i=0; i<200 && !logged; ++i)
+		this_thread::sleep_for(chrono::milliseconds{10});
+	BOOST_CHECK(logged);
+
+	target.release();
+	ordinary.join();
+	urgent.join();
+	async.flush();
+	BOOST_REQUIRE_EQUAL(target.written.size(), 4u);
+	BOOST_CHECK(target.written[0].message == L"ordinary 0");
+	BOOST_CHECK(target.written[1].message == L"alert");
+}
+
+BOOST_AUTO_TEST_CASE(drops_when_full) {
+	SlowLog target;
+	target.delay = chrono::milliseconds{1};
+	AsyncLog::Options options;
+	options.capacity = 10;
+	options.dropWhenFull = true;
+	AsyncLog async(target, options);
+	async.enableStats();
+	Logger logger(async, "ASYNC_TEST", INFO);
+
+	for(int i=0; i<100; ++i)
+		logger << "entry " << i << end_entry;
+	logger << EMERGENCY << "never dropped" << end_entry;
+	async.flush();
+
+	auto snap = async.getStats()->snapshot();
+	BOOST_CHECK(snap.dropped > 0);
+	BOOST_CHECK_EQUAL(target.written.size() + snap.dropped, 101u);
+	BOOST_CHECK(find_if(target.written.begin(), target.written.end(),
+			[](const Entry& e) { return e.severity == EMERGENCY; }) != target.written.end());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
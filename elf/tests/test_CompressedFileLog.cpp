@@ -0,0 +1,207 @@
+/*
+ * test_CompressedFileLog.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Georgios Dimitriadis
+ *
+ * Copyright (c) 2026, Georgios Dimitriadis
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <boost/test/unit_test.hpp>
+#include "../Logger.h"
+#include "../CompressedFileLog.h"
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <unistd.h>
+
+using namespace std;
+using namespace elf;
+
+BOOST_AUTO_TEST_SUITE(test_compressed_file_log)
+
+struct temp_path {
+	temp_path() : path("/tmp/elf_test_" + to_string(::getpid()) + ".elfz") { }
+	~temp_path() { ::remove(path.c_str()); }
+	const string path;
+};
+
+static size_t count_lines(const string& text) {
+	return static_cast<size_t>(count(text.begin(), text.end(), '\n'));
+}
+
+BOOST_AUTO_TEST_CASE(zlib_round_trip) {
+	ZlibCodec codec;
+	string raw(10000, 'x'), compressed, decompressed;
+	codec.compress(raw.data(), raw.size(), compressed);
+	BOOST_CHECK(compressed.size() < raw.size());
+	codec.decompress(compressed.data(), compressed.size(), raw.size(), decompressed);
+	BOOST_CHECK(decompressed == raw);
+}
+
+BOOST_AUTO_TEST_CASE(frames_decode_independently) {
+	temp_path file;
+	CompressedFileLog::Options options;
+	options.frameSize = 4096;
+	{
+		CompressedFileLog log(file.path, unique_ptr<Codec>(new ZlibCodec), INFO, options);
+		Logger logger(log, "COMPRESSED_TEST");
+		for(int i=0; i<2000; ++i)
+			logger << "entry number " << i << end_entry;
+	}
+
+	CompressedFileReader reader(file.path, unique_ptr<Codec>(new ZlibCodec));
+	BOOST_REQUIRE(reader.frames().size() > 1);
+
+	size_t entries = 0;
+	for(const auto& frame : reader.frames()) {
+		string raw = reader.read(frame);
+		BOOST_CHECK_EQUAL(count_lines(raw), frame.header.entries);
+		BOOST_CHECK(frame.header.firstTime <= frame.header.lastTime);
+		entries += frame.header.entries;
+	}
+	BOOST_CHECK_EQUAL(entries, 2000u);
+
+	string last = reader.read(reader.frames().back());
+	BOOST_CHECK(last.find("|COMPRESSED_TEST|entry number 1999\n") != string::npos);
+}
+
+BOOST_AUTO_TEST_CASE(read_time_range) {
+	temp_path file;
+	CompressedFileLog::Options options;
+	options.frameSize = 1;
+	CompressedFileLog log(file.path, unique_ptr<Codec>(new ZlibCodec), INFO, options);
+	Logger logger(log, "COMPRESSED_TEST");
+	for(int i=0; i<10; ++i)
+		logger << "entry " << i << end_entry;
+	log.flush();
+
+	CompressedFileReader reader(file.path, unique_ptr<Codec>(new ZlibCodec));
+	BOOST_REQUIRE_EQUAL(reader.frames().size(), 10u);
+	auto& fifth = reader.frames()[5].header;
+	string range = reader.readRange(fifth.firstTime, fifth.lastTime);
+	BOOST_CHECK(range.find("entry 5\n") != string::npos);
+	BOOST_CHECK(count_lines(range) < 10u);
+}
+
+BOOST_AUTO_TEST_CASE(frame_the_codec_fails_on_is_dropped) {
+	struct PickyCodec : ZlibCodec {
+		void compress(const char* data, size_t size, string& out) override {
+			if(string(data, size).find("poison") != string::npos)
+				throw runtime_error("cannot compress");
+			ZlibCodec::compress(data, size, out);
+		}
+	};
+	temp_path file;
+	CompressedFileLog::Options options;
+	options.frameSize = 1;
+	{
+		CompressedFileLog log(file.path, unique_ptr<Codec>(new PickyCodec), INFO, options);
+		log.enableStats();
+		Logger logger(log, "COMPRESSED_TEST");
+		logger << "before" << end_entry;
+		logger << "poison" << end_entry;
+		logger << "after" << end_entry;
+		log.flush();
+		BOOST_CHECK_EQUAL(log.getStats()->snapshot().dropped, 1u);
+	}
+
+	CompressedFileReader reader(file.path, unique_ptr<Codec>(new ZlibCodec));
+	BOOST_REQUIRE_EQUAL(reader.frames().size(), 2u);
+	BOOST_CHECK(reader.read(reader.frames()[1]).find("|after") != string::npos);
+}
+
+BOOST_AUTO_TEST_CASE(rejects_other_codec) {
+	struct OtherCodec : ZlibCodec {
+		string name() const override { return "other"; }
+	};
+	temp_path file;
+	{
+		CompressedFileLog log(file.path, unique_ptr<Codec>(new ZlibCodec));
+	}
+	BOOST_CHECK_THROW(CompressedFileReader(file.path, unique_ptr<Codec>(new OtherCodec)), runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(appends_across_restarts) {
+	temp_path file;
+	for(int run=0; run<2; ++run) {
+		CompressedFileLog log(file.path, unique_ptr<Codec>(new ZlibCodec));
+		Logger logger(log, "COMPRESSED_TEST");
+		logger << "run " << run << end_entry;
+	}
+
+	CompressedFileReader reader(file.path, unique_ptr<Codec>(new ZlibCodec));
+	BOOST_REQUIRE_EQUAL(reader.frames().size(), 2u);
+	BOOST_CHECK(reader.read(reader.frames()[0]).find("|run 0\n") != string::npos);
+	BOOST_CHECK(reader.read(reader.frames()[1]).find("|run 1\n") != string::npos);
+}
+
+BOOST_AUTO_TEST_CASE(append_with_other_codec_throws) {
+	struct OtherCodec : ZlibCodec {
+		string name() const override { return "other"; }
+	};
+	temp_path file;
+	{
+		CompressedFileLog log(file.path, unique_ptr<Codec>(new ZlibCodec));
+	}
+	BOOST_CHECK_THROW(CompressedFileLog(file.path, unique_ptr<Codec>(new OtherCodec)), runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(frame_cut_short_is_overwritten) {
+	temp_path file;
+	{
+		CompressedFileLog log(file.path, unique_ptr<Codec>(new ZlibCodec));
+		Logger logger(log, "COMPRESSED_TEST");
+		logger << "before" << end_entry;
+	}
+	{
+		// What a crash in the middle of writing a frame leaves behind.
+		ofstream out(file.path, ios::binary|ios::app);
+		out.write("ZFRM\x40\0\0\0\x40\0\0\0", 12);
+	}
+	{
+		CompressedFileLog log(file.path, unique_ptr<Codec>(new ZlibCodec));
+		Logger logger(log, "COMPRESSED_TEST");
+		logger << "after" << end_entry;
+	}
+
+	CompressedFileReader reader(file.path, unique_ptr<Codec>(new ZlibCodec));
+	BOOST_REQUIRE_EQUAL(reader.frames().size(), 2u);
+	BOOST_CHECK(reader.read(reader.frames()[1]).find("|after\n") != string::npos);
+}
+
+BOOST_AUTO_TEST_CASE(frame_header_is_little_endian) {
+	temp_path file;
+	{
+		CompressedFileLog log(file.path, unique_ptr<Codec>(new ZlibCodec));
+		Logger logger(log, "COMPRESSED_TEST");
+		logger << "entry" << end_entry;
+	}
+
+	ifstream in(file.path, ios::binary);
+	string bytes((istreambuf_iterator<char>(in)), istreambuf_iterator<char>());
+	const size_t header = 4 + 1 + 1 + ZlibCodec().name().size();
+	BOOST_REQUIRE(bytes.size() > header + 32);
+	BOOST_CHECK_EQUAL(bytes.substr(header, 4), "ZFRM");
+	// The entry count, low byte first.
+	BOOST_CHECK_EQUAL(bytes.substr(header + 12, 4), string("\x01\0\0\0", 4));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
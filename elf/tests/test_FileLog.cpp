@@ -0,0 +1,122 @@
+/*
+ * test_FileLog.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Georgios Dimitriadis
+ *
+ * Copyright (c) 2026, Georgios Dimitriadis
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <boost/test/unit_test.hpp>
+#include "../Logger.h"
+#include "../FileLog.h"
+#include <fstream>
+#include <cstdio>
+#include <thread>
+#include <unistd.h>
+
+using namespace std;
+using namespace elf;
+
+BOOST_AUTO_TEST_SUITE(test_file_log)
+
+struct temp_file {
+	temp_file() : path("/tmp/elf_test_" + to_string(::getpid()) + "_" + to_string(counter++) + ".log") { }
+	~temp_file() { ::remove(path.c_str()); }
+
+	vector<string> lines() const {
+		vector<string> result;
+		ifstream in(path);
+		for(string line; getline(in, line); )
+			result.push_back(line);
+		return result;
+	}
+
+	const string path;
+	static int counter;
+};
+int temp_file::counter = 0;
+
+BOOST_AUTO_TEST_CASE(writes_all_entries_in_order) {
+	temp_file file;
+	{
+		FileLog log(file.path, INFO);
+		Logger logger(log, "FILE_TEST");
+		for(int i=0; i<1000; ++i)
+			logger << "entry " << i << end_entry;
+	}
+
+	auto lines = file.lines();
+	BOOST_REQUIRE_EQUAL(lines.size(), 1000u);
+	BOOST_CHECK(lines[0].find("|INFO|") == 0);
+	BOOST_CHECK(lines[0].find("|FILE_TEST|entry 0") != string::npos);
+	BOOST_CHECK(lines[999].find("|FILE_TEST|entry 999") != string::npos);
+}
+
+BOOST_AUTO_TEST_CASE(coalesces_entries_per_write) {
+	temp_file file;
+	FileLog::Options options;
+	options.maxBatchEntries = 100;
+	options.maxBatchDelay = chrono::seconds{10};
+	FileLog log(file.path, INFO, options);
+	log.enableStats();
+	Logger logger(log, "FILE_TEST");
+	for(int i=0; i<1000; ++i)
+		logger << "entry " << i << end_entry;
+	log.flush();
+
+	auto snap = log.getStats()->snapshot();
+	BOOST_CHECK_EQUAL(snap.accepted, 1000u);
+	BOOST_CHECK_EQUAL(snap.writes, 10u);
+	BOOST_CHECK_CLOSE(snap.entriesPerWrite(), 100.0, 0.001);
+	BOOST_CHECK_EQUAL(file.lines().size(), 1000u);
+}
+
+BOOST_AUTO_TEST_CASE(pending_entries_written_on_flush) {
+	temp_file file;
+	FileLog::Options options;
+	options.maxBatchDelay = chrono::seconds{10};
+	options.syncBytes = 1;
+	FileLog log(file.path, INFO, options);
+	Logger logger(log, "FILE_TEST");
+	logger << "pending" << end_entry;
+	BOOST_CHECK(file.lines().empty());
+
+	log.flush();
+	BOOST_CHECK_EQUAL(file.lines().size(), 1u);
+}
+
+BOOST_AUTO_TEST_CASE(idle_batch_written_after_max_delay) {
+	temp_file file;
+	FileLog::Options options;
+	options.maxBatchDelay = chrono::milliseconds{20};
+	FileLog log(file.path, INFO, options);
+	Logger logger(log, "FILE_TEST");
+	logger << "idle" << end_entry;
+
+	this_thread::sleep_for(chrono::milliseconds{500});
+	BOOST_CHECK_EQUAL(file.lines().size(), 1u);
+}
+
+BOOST_AUTO_TEST_CASE(open_failure_throws) {
+	BOOST_CHECK_THROW(FileLog("/nonexistent/dir/elf.log"), system_error);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,145 @@
+/*
+ * test_FilterLog.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Georgios Dimitriadis
+ *
+ * Copyright (c) 2026, Georgios Dimitriadis
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <boost/test/unit_test.hpp>
+#include "../Logger.h"
+#include "../FilterLog.h"
+
+using namespace std;
+using namespace elf;
+
+BOOST_AUTO_TEST_SUITE(test_filter_log)
+
+struct CollectingLog : public ILog {
+	CollectingLog() : ILog(DEBUG) { }
+
+	vector<logstring> messages;
+
+	void flush() override { }
+protected:
+	void addEntry(const Entry& entry) override { messages.push_back(entry.message); }
+};
+
+struct TraceIdTag { };
+
+FilterRule rule(FilterRule::Action action, const string& facilityPrefix, Severity maxSeverity=DEBUG) {
+	FilterRule r(action);
+	r.facilityPrefix = facilityPrefix;
+	r.maxSeverity = maxSeverity;
+	return r;
+}
+
+void log_from_site(Logger& logger, Severity severity, const string& message) {
+	logger << ELF_SITE << severity << message << end_entry;
+}
+
+BOOST_AUTO_TEST_CASE(first_matching_rule_decides) {
+	CollectingLog sink;
+	FilterRule noisyFile(FilterRule::REJECT);
+	noisyFile.file = "noisy.cpp";
+	FilterLog filter(sink, FilterRule::REJECT, {
+		noisyFile,
+		rule(FilterRule::ACCEPT, "FILTER_TEST.DB", INFO),
+		rule(FilterRule::ACCEPT, "", ERROR),
+	});
+
+	Logger db(filter, "FILTER_TEST.DB");
+	Logger pool(filter, "FILTER_TEST.DB.POOL");
+	Logger dbx(filter, "FILTER_TEST.DBX");
+	db << INFO << "db info" << end_entry;
+	db << DEBUG << "db debug" << end_entry;
+	pool << INFO << "pool info" << end_entry;
+	dbx << INFO << "dbx info" << end_entry;
+	dbx << ERROR << "dbx error" << end_entry;
+	db << ERROR << location("query", "/src/noisy.cpp", 3) << "noisy error" << end_entry;
+
+	BOOST_REQUIRE_EQUAL(sink.messages.size(), 3u);
+	BOOST_CHECK(sink.messages[0] == L"db info");
+	BOOST_CHECK(sink.messages[1] == L"pool info");
+	BOOST_CHECK(sink.messages[2] == L"dbx error");
+}
+
+BOOST_AUTO_TEST_CASE(cached_site_decisions_follow_rule_changes) {
+	CollectingLog sink;
+	FilterLog filter(sink, FilterRule::ACCEPT, {rule(FilterRule::REJECT, "FILTER_TEST.SITE", DEBUG)});
+	Logger logger(filter, "FILTER_TEST.SITE", DEBUG);
+
+	for(int i=0; i<3; ++i)
+		log_from_site(logger, INFO, "rejected");
+	BOOST_CHECK(sink.messages.empty());
+
+	filter.setRules({rule(FilterRule::REJECT, "FILTER_TEST.SITE", ERROR)});
+	log_from_site(logger, INFO, "info");
+	log_from_site(logger, ERROR, "error");
+	BOOST_REQUIRE_EQUAL(sink.messages.size(), 1u);
+	BOOST_CHECK(sink.messages[0] == L"info");
+
+	// The same statement through another facility is not served from the cache.
+	Logger other(filter, "FILTER_TEST.OTHER", DEBUG);
+	log_from_site(other, ERROR, "other error");
+	BOOST_REQUIRE_EQUAL(sink.messages.size(), 2u);
+	BOOST_CHECK(sink.messages[1] == L"other error");
+}
+
+BOOST_AUTO_TEST_CASE(custom_data_rules_are_evaluated_per_entry) {
+	CollectingLog sink;
+	FilterRule traced(FilterRule::ACCEPT);
+	traced.requireKey<TraceIdTag>();
+	FilterLog filter(sink, FilterRule::REJECT, {traced});
+	Logger logger(filter, "FILTER_TEST.TRACE", DEBUG);
+
+	Entry entry;
+	entry.facility = "FILTER_TEST.TRACE";
+	static const CallSite callSite("handler", "trace.cpp", 10);
+	entry.site = &callSite;
+	entry.message = L"untraced";
+	filter.handle(entry);
+	entry.set<TraceIdTag>(42);
+	entry.message = L"traced";
+	filter.handle(entry);
+
+	BOOST_REQUIRE_EQUAL(sink.messages.size(), 1u);
+	BOOST_CHECK(sink.messages[0] == L"traced");
+}
+
+BOOST_AUTO_TEST_CASE(bulk_handle_forwards_accepted_runs) {
+	CollectingLog sink;
+	FilterLog filter(sink, FilterRule::ACCEPT, {rule(FilterRule::REJECT, "", DEBUG), rule(FilterRule::ACCEPT, "", INFO)});
+	filter.setRules({rule(FilterRule::ACCEPT, "", INFO)}, FilterRule::REJECT);
+
+	vector<Entry> entries(6);
+	for(size_t i=0; i<entries.size(); ++i) {
+		entries[i].severity = i % 3 ? INFO : DEBUG;
+		entries[i].message = to_logstring(i);
+	}
+	filter.handle(entries.data(), entries.size());
+
+	BOOST_REQUIRE_EQUAL(sink.messages.size(), 4u);
+	BOOST_CHECK(sink.messages[0] == L"1");
+	BOOST_CHECK(sink.messages[3] == L"5");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
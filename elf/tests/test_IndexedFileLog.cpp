@@ -0,0 +1,179 @@
+/*
+ * test_IndexedFileLog.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Georgios Dimitriadis
+ *
+ * Copyright (c) 2026, Georgios Dimitriadis
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <boost/test/unit_test.hpp>
+#include "../Logger.h"
+#include "../IndexedFileLog.h"
+#include <cstdio>
+#include <csignal>
+#include <fstream>
+#include <sys/resource.h>
+#include <unistd.h>
+
+using namespace std;
+using namespace elf;
+
+BOOST_AUTO_TEST_SUITE(test_indexed_file_log)
+
+struct temp_log {
+	temp_log() : path("/tmp/elf_test_" + to_string(::getpid()) + "_indexed.log") { }
+	~temp_log() {
+		::remove(path.c_str());
+		::remove((path + ".idx").c_str());
+	}
+	const string path;
+};
+
+static int64_t nanos(const logtime& time) {
+	return chrono::duration_cast<chrono::nanoseconds>(time.time_since_epoch()).count();
+}
+
+BOOST_AUTO_TEST_CASE(blocks_cover_the_whole_file) {
+	temp_log log;
+	{
+		IndexedFileLog sink(log.path, 1024, DEBUG);
+		Logger logger(sink, "INDEX_TEST");
+		for(int i=0; i<500; ++i)
+			logger << "entry " << i << end_entry;
+	}
+
+	LogIndex index(log.path);
+	BOOST_REQUIRE(index.blocks().size() > 10);
+
+	uint64_t offset = 0;
+	uint32_t entries = 0;
+	for(const auto& block : index.blocks()) {
+		BOOST_CHECK_EQUAL(block.offset, offset);
+		BOOST_CHECK(block.firstTime <= block.lastTime);
+		offset += block.size;
+		entries += block.entries;
+	}
+	BOOST_CHECK_EQUAL(entries, 500u);
+
+	ifstream in(log.path, ios::binary|ios::ate);
+	BOOST_CHECK_EQUAL(offset, static_cast<uint64_t>(in.tellg()));
+}
+
+BOOST_AUTO_TEST_CASE(select_skips_blocks_by_time_severity_and_facility) {
+	temp_log log;
+	logtime middle;
+	{
+		IndexedFileLog sink(log.path, 256, DEBUG);
+		Logger db(sink, "db.pool.conn");
+		Logger net(sink, "net");
+		for(int i=0; i<50; ++i)
+			net << "noise " << i << end_entry;
+		sink.flush();
+		middle = chrono::high_resolution_clock::now();
+		db << ERROR << "connection lost" << end_entry;
+		sink.flush();
+		for(int i=0; i<50; ++i)
+			net << "noise " << i << end_entry;
+	}
+
+	LogIndex index(log.path);
+	const int64_t all_from = numeric_limits<int64_t>::min(), all_to = numeric_limits<int64_t>::max();
+	BOOST_CHECK_EQUAL(index.select(all_from, all_to).size(), index.blocks().size());
+
+	auto errors = index.select(all_from, all_to, ERROR);
+	BOOST_REQUIRE_EQUAL(errors.size(), 1u);
+	BOOST_CHECK_EQUAL(errors[0].entries, 1u);
+
+	BOOST_CHECK_EQUAL(index.select(all_from, all_to, ERROR, "db").size(), 1u);
+	BOOST_CHECK_EQUAL(index.select(all_from, all_to, ERROR, "db.pool.conn").size(), 1u);
+
+	auto later = index.select(nanos(middle), all_to);
+	BOOST_CHECK(later.size() < index.blocks().size());
+	BOOST_CHECK(later.front().offset == errors[0].offset);
+
+	ifstream in(log.path, ios::binary);
+	string line(errors[0].size, '\0');
+	in.seekg(static_cast<streamoff>(errors[0].offset));
+	in.read(&line[0], static_cast<streamsize>(line.size()));
+	BOOST_CHECK(line.find("|ERROR|") == 0);
+	BOOST_CHECK(line.find("|db.pool.conn|connection lost\n") != string::npos);
+}
+
+BOOST_AUTO_TEST_CASE(appending_continues_offsets) {
+	temp_log log;
+	for(int run=0; run<2; ++run) {
+		IndexedFileLog sink(log.path, 1 << 20, DEBUG);
+		Logger logger(sink, "INDEX_TEST");
+		logger << "run " << run << end_entry;
+	}
+
+	LogIndex index(log.path);
+	BOOST_REQUIRE_EQUAL(index.blocks().size(), 2u);
+	BOOST_CHECK_EQUAL(index.blocks()[1].offset, index.blocks()[0].size);
+}
+
+BOOST_AUTO_TEST_CASE(facility_bits_are_fnv1a) {
+	// FNV-1a 64 of "a" is 0xaf63dc4c8601ec8c.
+	BOOST_CHECK_EQUAL(IndexBlock::facilityBit("a"), uint64_t{1} << (0x8c % 64));
+	BOOST_CHECK_EQUAL(IndexBlock::facilityBits("a.a"), IndexBlock::facilityBit("a") | IndexBlock::facilityBit("a.a"));
+}
+
+BOOST_AUTO_TEST_CASE(offsets_follow_bytes_actually_written) {
+	temp_log log;
+	rlimit unlimited;
+	BOOST_REQUIRE(::getrlimit(RLIMIT_FSIZE, &unlimited) == 0);
+	auto previous = ::signal(SIGXFSZ, SIG_IGN);
+	{
+		IndexedFileLog sink(log.path, 1 << 20, DEBUG);
+		sink.enableStats();
+		Logger logger(sink, "INDEX_TEST");
+		logger << "before" << end_entry;
+		sink.flush();
+
+		// Lets only the start of the next entry into the file.
+		ifstream in(log.path, ios::binary|ios::ate);
+		rlimit limit = unlimited;
+		limit.rlim_cur = static_cast<rlim_t>(in.tellg()) + 10;
+		BOOST_REQUIRE(::setrlimit(RLIMIT_FSIZE, &limit) == 0);
+		logger << "cut short" << end_entry;
+		sink.flush();
+		::setrlimit(RLIMIT_FSIZE, &unlimited);
+		BOOST_CHECK_EQUAL(sink.getStats()->snapshot().dropped, 1u);
+
+		logger << "after" << end_entry;
+	}
+	::signal(SIGXFSZ, previous);
+
+	LogIndex index(log.path);
+	BOOST_REQUIRE_EQUAL(index.blocks().size(), 2u);
+	BOOST_CHECK_EQUAL(index.blocks()[0].entries, 1u);
+	BOOST_CHECK_EQUAL(index.blocks()[1].entries, 1u);
+	BOOST_CHECK_EQUAL(index.blocks()[1].offset, index.blocks()[0].size + 10);
+
+	ifstream in(log.path, ios::binary);
+	string line(index.blocks()[1].size, '\0');
+	in.seekg(static_cast<streamoff>(index.blocks()[1].offset));
+	in.read(&line[0], static_cast<streamsize>(line.size()));
+	BOOST_CHECK(line.find("|INDEX_TEST|after\n") != string::npos);
+	BOOST_CHECK_EQUAL(line.find("cut short"), string::npos);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
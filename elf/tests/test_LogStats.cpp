@@ -0,0 +1,126 @@
+/*
+ * test_LogStats.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Georgios Dimitriadis
+ *
+ * Copyright (c) 2026, Georgios Dimitriadis
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <boost/test/unit_test.hpp>
+#include "../Logger.h"
+#include "../StreamLog.h"
+#include <sstream>
+#include <thread>
+
+using namespace std;
+using namespace elf;
+
+BOOST_AUTO_TEST_SUITE(test_log_stats)
+
+BOOST_AUTO_TEST_CASE(histogram_percentiles) {
+	LatencyHistogram hist;
+	for(int i=0; i<99; ++i)
+		hist.record(chrono::nanoseconds{100});
+	hist.record(chrono::nanoseconds{100000});
+
+	auto snap = hist.snapshot();
+	BOOST_CHECK_EQUAL(snap.count, 100u);
+	BOOST_CHECK_EQUAL(snap.max, 100000u);
+	BOOST_CHECK_EQUAL(snap.percentile(0.5), 127u);
+	BOOST_CHECK_EQUAL(snap.percentile(0.999), 100000u);
+}
+
+BOOST_AUTO_TEST_CASE(value_histogram_covers_the_full_range) {
+	ValueHistogram hist;
+	hist.record(0);
+	hist.record(5);
+	hist.record(UINT64_MAX);
+
+	auto snap = hist.snapshot();
+	BOOST_CHECK_EQUAL(snap.count, 3u);
+	BOOST_CHECK_EQUAL(snap.buckets[0], 1u);
+	BOOST_CHECK_EQUAL(snap.buckets[3], 1u);
+	BOOST_CHECK_EQUAL(snap.buckets[ValueHistogram::BUCKETS - 1], 1u);
+	BOOST_CHECK_EQUAL(snap.max, UINT64_MAX);
+	BOOST_CHECK_EQUAL(snap.percentile(0.5), 7u);
+	BOOST_CHECK_EQUAL(snap.percentile(1.0), UINT64_MAX);
+}
+
+BOOST_AUTO_TEST_CASE(stats_disabled_by_default) {
+	ostringstream oss;
+	StreamLog log(oss);
+	BOOST_CHECK(log.getStats() == nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(stream_log_counts_accepted_filtered_and_bytes) {
+	ostringstream oss;
+	StreamLog log(oss, INFO);
+	log.enableStats();
+	Logger logger(log, "STATS_TEST");
+
+	logger << INFO << "written" << end_entry;
+	logger << WARNING << "written" << end_entry;
+	logger << DEBUG << "filtered" << end_entry;
+
+	auto snap = log.getStats()->snapshot();
+	BOOST_CHECK_EQUAL(snap.accepted, 2u);
+	BOOST_CHECK_EQUAL(snap.filtered, 1u);
+	BOOST_CHECK_EQUAL(snap.dropped, 0u);
+	BOOST_CHECK_EQUAL(snap.writes, 2u);
+	BOOST_CHECK_EQUAL(snap.bytes, oss.str().size());
+	BOOST_CHECK_EQUAL(snap.addEntryLatency.count, 2u);
+	BOOST_CHECK_EQUAL(snap.endToEndLatency.count, 2u);
+}
+
+BOOST_AUTO_TEST_CASE(snapshot_while_logging) {
+	ostringstream oss;
+	StreamLog log(oss, INFO);
+	LogStats& stats = log.enableStats();
+	Logger logger(log, "STATS_TEST");
+
+	thread writer([&] {
+		for(int i=0; i<1000; ++i)
+			logger << "entry " << i << end_entry;
+	});
+	uint64_t last = 0;
+	while(last < 1000) {
+		uint64_t accepted = stats.snapshot().accepted;
+		BOOST_REQUIRE(accepted >= last);
+		last = accepted;
+	}
+	writer.join();
+}
+
+BOOST_AUTO_TEST_CASE(prometheus_dump) {
+	ostringstream oss;
+	StreamLog log(oss, INFO);
+	log.enableStats();
+	Logger logger(log, "STATS_TEST");
+	logger << "hello" << end_entry;
+
+	ostringstream prom;
+	log.getStats()->snapshot().writePrometheus(prom, "stream");
+	BOOST_CHECK(prom.str().find("elf_entries_accepted_total{sink=\"stream\"} 1\n") != string::npos);
+	BOOST_CHECK(prom.str().find("elf_add_entry_latency_ns_count{sink=\"stream\"} 1\n") != string::npos);
+	BOOST_CHECK(log.getStats()->snapshot().summary().find("accepted=1 ") == 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -27,6 +27,7 @@
 #define BOOST_TEST_MODULE test_logger
 #include <boost/test/included/unit_test.hpp>
 #include "../Logger.h"
+#include "../CallSite.h"
 #include <map>
 #include <list>
 
@@ -39,6 +40,20 @@ ostream& operator << (ostream& os, const logstring& lstr) {
 }
 }
 
+// Counts how often it is formatted into a message.
+struct CountedFormat { };
+static int countedFormats = 0;
+
+namespace elf {
+template<>
+struct logstring_cast<CountedFormat> {
+	static logstring cast(const CountedFormat&) {
+		++countedFormats;
+		return L"counted";
+	}
+};
+}
+
 BOOST_AUTO_TEST_SUITE(test_logger)
 
 struct TestLog : public ILog {
@@ -200,6 +215,26 @@ BOOST_AUTO_TEST_CASE(log_full_location_on_low_level) {
 	BOOST_CHECK_EQUAL(entry.location.line, line);
 }
 
+BOOST_AUTO_TEST_CASE(log_site_on_low_level) {
+	TestLog testLog;
+	testLog.setMaxSeverity(DEBUG);
+	Logger logger(testLog, "TESTFACILITY", INFO);
+	logger << EMERGENCY << ELF_SITE << end_entry;
+	auto line = __LINE__ - 1;
+
+	BOOST_REQUIRE(not testLog.entries.empty());
+	BOOST_REQUIRE(not testLog.entries[EMERGENCY].empty());
+
+	auto entry = testLog.entries[EMERGENCY].front();
+	BOOST_REQUIRE(entry.site != nullptr);
+	BOOST_CHECK(&entry.where() == &entry.site->location);
+	BOOST_CHECK(entry.location.file.empty());
+	BOOST_CHECK_EQUAL(entry.where().function, __func__);
+	BOOST_CHECK_EQUAL(entry.where().file, __FILE__);
+	BOOST_CHECK_EQUAL(entry.where().line, line);
+	BOOST_CHECK(entry.facilityKey == &FacilityTree::instance().resolve("TESTFACILITY"));
+}
+
 BOOST_AUTO_TEST_CASE(log_foo_on_low_level) {
 	TestLog testLog;
 	testLog.setMaxSeverity(DEBUG);
@@ -447,4 +482,200 @@ BOOST_AUTO_TEST_CASE(write_to_two_logs_from_one_logger_added_at_ctor) {
 	BOOST_CHECK(testLogB.entries[EMERGENCY].front().message == L"this should be in both logs");
 }
 
+BOOST_AUTO_TEST_CASE(facility_threshold_inherited_from_ancestor) {
+	FacilityTree tree;
+	tree.setThreshold("db", WARNING);
+	tree.setThreshold("db.pool.conn", DEBUG);
+
+	BOOST_CHECK_EQUAL(tree.getThreshold("db"), WARNING);
+	BOOST_CHECK_EQUAL(tree.getThreshold("db.pool"), WARNING);
+	BOOST_CHECK_EQUAL(tree.getThreshold("db.pool.conn"), DEBUG);
+	BOOST_CHECK_EQUAL(tree.getThreshold("db.pool.conn.socket"), DEBUG);
+	BOOST_CHECK_EQUAL(tree.getThreshold("net"), DEBUG);
+}
+
+BOOST_AUTO_TEST_CASE(facility_threshold_updated_in_place) {
+	FacilityTree tree;
+	const FacilityTree::threshold_t& pool = tree.resolve("db.pool");
+	BOOST_CHECK_EQUAL(pool.load(), DEBUG);
+
+	tree.setThreshold("db", ERROR);
+	BOOST_CHECK_EQUAL(pool.load(), ERROR);
+
+	tree.setThreshold("db.pool", NOTICE);
+	tree.setThreshold("db", CRITICAL);
+	BOOST_CHECK_EQUAL(pool.load(), NOTICE);
+
+	tree.clearThreshold("db.pool");
+	BOOST_CHECK_EQUAL(pool.load(), CRITICAL);
+
+	tree.reset(INFO);
+	BOOST_CHECK_EQUAL(pool.load(), INFO);
+}
+
+BOOST_AUTO_TEST_CASE(facility_threshold_skips_formatting) {
+	TestLog testLog;
+	testLog.setMaxSeverity(DEBUG);
+	Logger logger(testLog, "FACILITY_FORMAT_TEST", INFO);
+
+	FacilityTree::instance().setThreshold("FACILITY_FORMAT_TEST", WARNING);
+	countedFormats = 0;
+	logger << INFO << CountedFormat() << end_entry;
+	BOOST_CHECK_EQUAL(countedFormats, 0);
+	logger << ERROR << CountedFormat() << end_entry;
+	BOOST_CHECK_EQUAL(countedFormats, 1);
+	FacilityTree::instance().reset();
+
+	BOOST_CHECK(testLog.entries[INFO].empty());
+	BOOST_REQUIRE_EQUAL(testLog.entries[ERROR].size(), 1u);
+	BOOST_CHECK(testLog.entries[ERROR].front().message == L"counted");
+}
+
+BOOST_AUTO_TEST_CASE(severity_raised_after_skipped_data_drops_entry) {
+	TestLog testLog;
+	testLog.setMaxSeverity(DEBUG);
+	Logger logger(testLog, "FACILITY_ORDER_TEST", INFO);
+
+	FacilityTree::instance().setThreshold("FACILITY_ORDER_TEST", WARNING);
+	logger << "text" << ERROR << end_entry;
+	logger << ERROR << "complete" << end_entry;
+	FacilityTree::instance().reset();
+
+	BOOST_REQUIRE_EQUAL(testLog.entries[ERROR].size(), 1u);
+	BOOST_CHECK(testLog.entries[ERROR].front().message == L"complete");
+}
+
+BOOST_AUTO_TEST_CASE(facility_threshold_filters_duplicated_logger) {
+	TestLog testLog;
+	testLog.setMaxSeverity(DEBUG);
+	Logger logger(testLog, "FACILITY_TEST", INFO);
+	Logger poolLogger = logger.duplicate("FACILITY_TEST.pool");
+
+	FacilityTree::instance().setThreshold("FACILITY_TEST", WARNING);
+	logger << INFO << "filtered" << end_entry;
+	poolLogger << INFO << "filtered" << end_entry;
+	poolLogger << ERROR << "passed" << end_entry;
+
+	FacilityTree::instance().setThreshold("FACILITY_TEST.pool", DEBUG);
+	poolLogger << INFO << "passed" << end_entry;
+	FacilityTree::instance().reset();
+
+	BOOST_CHECK(testLog.entries[INFO].size() == 1);
+	BOOST_CHECK(testLog.entries[ERROR].size() == 1);
+	BOOST_CHECK(poolLogger.isEnabled(DEBUG));
+}
+
+struct BulkTestLog : public TestLog {
+	vector<size_t> bulkSizes;
+protected:
+	void addEntries(const Entry* entries, size_t count) override {
+		bulkSizes.push_back(count);
+		ILog::addEntries(entries, count);
+	}
+};
+
+BOOST_AUTO_TEST_CASE(batching_hands_over_full_batches) {
+	BulkTestLog testLog;
+	testLog.setMaxSeverity(DEBUG);
+	Logger logger(testLog, "BATCH_TEST", INFO);
+	Logger::BatchOptions options;
+	options.maxEntries = 10;
+	options.maxDelay = chrono::seconds{10};
+	logger.enableBatching(options);
+
+	for(int i=0; i<25; ++i)
+		logger << "entry " << i << end_entry;
+
+	BOOST_REQUIRE_EQUAL(testLog.bulkSizes.size(), 2u);
+	BOOST_CHECK_EQUAL(testLog.bulkSizes[0], 10u);
+	BOOST_CHECK_EQUAL(testLog.entries[INFO].size(), 20u);
+
+	logger.flushBatches();
+	BOOST_REQUIRE_EQUAL(testLog.entries[INFO].size(), 25u);
+	for(int i=0; i<25; ++i)
+		BOOST_CHECK_EQUAL(atoi(testLog.entries[INFO][i].message.substr(6)), i);
+}
+
+BOOST_AUTO_TEST_CASE(batching_flushes_on_severe_entry) {
+	BulkTestLog testLog;
+	testLog.setMaxSeverity(DEBUG);
+	Logger logger(testLog, "BATCH_TEST", INFO);
+	Logger::BatchOptions options;
+	options.maxEntries = 100;
+	options.maxDelay = chrono::seconds{10};
+	options.flushSeverity = ERROR;
+	logger.enableBatching(options);
+
+	logger << "first" << end_entry;
+	logger << WARNING << "second" << end_entry;
+	BOOST_CHECK(testLog.bulkSizes.empty());
+
+	logger << ERROR << "third" << end_entry;
+	BOOST_REQUIRE_EQUAL(testLog.bulkSizes.size(), 1u);
+	BOOST_CHECK_EQUAL(testLog.bulkSizes[0], 3u);
+	BOOST_CHECK(testLog.entries[ERROR].front().message == L"third");
+}
+
+BOOST_AUTO_TEST_CASE(batching_hands_over_idle_batch_after_max_delay) {
+	BulkTestLog testLog;
+	testLog.setMaxSeverity(DEBUG);
+	Logger logger(testLog, "BATCH_TEST", INFO);
+	Logger::BatchOptions options;
+	options.maxEntries = 100;
+	options.maxDelay = chrono::milliseconds{20};
+	logger.enableBatching(options);
+
+	logger << "lonely" << end_entry;
+	this_thread::sleep_for(chrono::milliseconds{500});
+
+	BOOST_REQUIRE_EQUAL(testLog.bulkSizes.size(), 1u);
+	BOOST_CHECK_EQUAL(testLog.bulkSizes[0], 1u);
+	BOOST_CHECK(testLog.entries[INFO].front().message == L"lonely");
+}
+
+BOOST_AUTO_TEST_CASE(batching_skips_filtered_entries) {
+	BulkTestLog testLog;
+	testLog.setMaxSeverity(NOTICE);
+	testLog.enableStats();
+	Logger logger(testLog, "BATCH_TEST", INFO);
+	logger.enableBatching();
+
+	logger << NOTICE << "a" << end_entry;
+	logger << INFO << "filtered" << end_entry;
+	logger << NOTICE << "b" << end_entry;
+	logger.flushBatches();
+
+	BOOST_CHECK_EQUAL(testLog.entries[NOTICE].size(), 2u);
+	BOOST_CHECK(testLog.entries[INFO].empty());
+	BOOST_CHECK_EQUAL(testLog.getStats()->snapshot().filtered, 1u);
+	BOOST_CHECK_EQUAL(testLog.getStats()->snapshot().accepted, 2u);
+}
+
+BOOST_AUTO_TEST_CASE(batching_multithreaded_keeps_per_thread_order) {
+	TestLog testLog;
+	testLog.setMaxSeverity(INFO);
+	Logger logger(testLog, "BATCH_TEST", INFO);
+	logger.enableBatching();
+
+	log_writer writer1("this is writer1 writing", 1000);
+	log_writer writer2("this is writer2 writing", 1000);
+	{
+		thread firstThread(writer1, ref(logger));
+		thread secondThread(writer2, ref(logger));
+		firstThread.join();
+		secondThread.join();
+	}
+	logger.flushBatches();
+
+	int firstWrites(0), secondWrites(0);
+	for(const auto& logEntry : testLog.entries[INFO]) {
+		if(logEntry.message.find(L"this is writer1 writing:")==0 && atoi(logEntry.message.substr(24))==firstWrites)
+			++firstWrites;
+		else if(logEntry.message.find(L"this is writer2 writing:")==0 && atoi(logEntry.message.substr(24))==secondWrites)
+			++secondWrites;
+	}
+	BOOST_CHECK_EQUAL(firstWrites, 1000);
+	BOOST_CHECK_EQUAL(secondWrites, 1000);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,131 @@
+/*
+ * test_MetricsLog.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Georgios Dimitriadis
+ *
+ * Copyright (c) 2026, Georgios Dimitriadis
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <boost/test/unit_test.hpp>
+#include "../Logger.h"
+#include "../MetricsLog.h"
+#include <sstream>
+#include <thread>
+
+using namespace std;
+using namespace elf;
+
+BOOST_AUTO_TEST_SUITE(test_metrics_log)
+
+struct LatencyTag { };
+
+BOOST_AUTO_TEST_CASE(counts_by_facility_severity_and_site) {
+	MetricsLog metrics;
+	Logger db(metrics, "METRICS_TEST.DB");
+	Logger pool(metrics, "METRICS_TEST.DB.POOL");
+	Logger net(metrics, "METRICS_TEST.NET");
+
+	for(int i=0; i<10; ++i)
+		db << INFO << "query" << end_entry;
+	db << ERROR << location("query", "db.cpp", 42) << "failed" << end_entry;
+	pool << WARNING << location("acquire", "pool.cpp", 7) << "exhausted" << end_entry;
+	pool << WARNING << location("acquire", "pool.cpp", 7) << "exhausted" << end_entry;
+	net << DEBUG << "tick" << end_entry;
+
+	auto snap = metrics.snapshot();
+	BOOST_CHECK_EQUAL(snap.facilities["METRICS_TEST.DB"].bySeverity[INFO], 10u);
+	BOOST_CHECK_EQUAL(snap.facilities["METRICS_TEST.DB"].bySeverity[ERROR], 1u);
+	BOOST_CHECK_EQUAL(snap.count(WARNING, "METRICS_TEST.DB"), 3u);
+	BOOST_CHECK_EQUAL(snap.count(DEBUG, "METRICS_TEST"), 14u);
+	BOOST_CHECK_EQUAL(snap.count(DEBUG, "METRICS_TEST.D"), 0u);
+	BOOST_CHECK_EQUAL(snap.sites.size(), 2u);
+	BOOST_CHECK_EQUAL(snap.sites["acquire @ pool.cpp:7"].total(), 2u);
+	BOOST_CHECK_EQUAL(snap.overflow, 0u);
+}
+
+BOOST_AUTO_TEST_CASE(snapshot_with_reset_loses_nothing) {
+	MetricsLog metrics;
+	const int threads = 4, perThread = 20000;
+	atomic<bool> done(false);
+	uint64_t seen = 0;
+
+	thread sampler([&] {
+		while(!done)
+			seen += metrics.snapshot(true).count(DEBUG);
+	});
+	vector<thread> loggers;
+	for(int t=0; t<threads; ++t) {
+		loggers.emplace_back([&, t] {
+			Logger logger(metrics, "METRICS_TEST.T" + to_string(t % 2));
+			for(int i=0; i<perThread; ++i)
+				logger << "entry" << end_entry;
+		});
+	}
+	for(auto& logger : loggers)
+		logger.join();
+	done = true;
+	sampler.join();
+	seen += metrics.snapshot(true).count(DEBUG);
+
+	BOOST_CHECK_EQUAL(seen, static_cast<uint64_t>(threads * perThread));
+	BOOST_CHECK_EQUAL(metrics.snapshot().count(DEBUG), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(full_table_counts_overflow) {
+	MetricsLog::Options options;
+	options.maxFacilities = 2;
+	MetricsLog metrics(DEBUG, options);
+	for(int i=0; i<5; ++i) {
+		Logger logger(metrics, "METRICS_TEST.F" + to_string(i));
+		logger << "entry" << end_entry;
+	}
+
+	auto snap = metrics.snapshot();
+	BOOST_CHECK_EQUAL(snap.facilities.size(), 2u);
+	BOOST_CHECK_EQUAL(snap.overflow, 3u);
+}
+
+BOOST_AUTO_TEST_CASE(field_histogram_and_prometheus_output) {
+	MetricsLog metrics;
+	metrics.recordField<LatencyTag, int>("latency_us");
+
+	Entry entry;
+	entry.facility = "METRICS_TEST";
+	entry.severity = ERROR;
+	for(int value : {3, 100, -5}) {
+		entry.set<LatencyTag>(value);
+		metrics.handle(entry);
+	}
+	metrics.handle(Entry());
+
+	auto snap = metrics.snapshot();
+	BOOST_CHECK_EQUAL(snap.field.count, 3u);
+	BOOST_CHECK_EQUAL(snap.field.max, 100u);
+	BOOST_CHECK_EQUAL(snap.field.sum, 103u);
+
+	ostringstream oss;
+	snap.writePrometheus(oss, "app");
+	const string text = oss.str();
+	BOOST_CHECK(text.find("elf_facility_entries_total{log=\"app\",facility=\"METRICS_TEST\",severity=\"ERROR\"} 3\n") != string::npos);
+	BOOST_CHECK(text.find("elf_field_count{log=\"app\",field=\"latency_us\"} 3\n") != string::npos);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,113 @@
+/*
+ * test_ShardedLog.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Georgios Dimitriadis
+ *
+ * Copyright (c) 2026, Georgios Dimitriadis
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <boost/test/unit_test.hpp>
+#include "../Logger.h"
+#include "../ShardedLog.h"
+#include <thread>
+
+using namespace std;
+using namespace elf;
+
+BOOST_AUTO_TEST_SUITE(test_sharded_log)
+
+struct CollectingLog : public ILog {
+	CollectingLog() : ILog(DEBUG), handoffs(0) { }
+
+	vector<Entry> written;
+	int handoffs;
+
+	void flush() override { }
+protected:
+	void addEntries(const Entry* entries, size_t count) override {
+		++handoffs;
+		ILog::addEntries(entries, count);
+	}
+	void addEntry(const Entry& entry) override { written.push_back(entry); }
+};
+
+BOOST_AUTO_TEST_CASE(merges_threads_in_timestamp_order) {
+	CollectingLog target;
+	{
+		ShardedLog::Options options;
+		options.shards = 4;
+		options.drainInterval = chrono::milliseconds{5};
+		ShardedLog sharded(target, options);
+
+		vector<thread> writers;
+		for(int t=0; t<4; ++t) {
+			writers.emplace_back([&sharded, t] {
+				Logger logger(sharded, "SHARD_TEST_" + to_string(t));
+				for(int i=0; i<1000; ++i)
+					logger << i << end_entry;
+			});
+		}
+		for(auto& writer : writers)
+			writer.join();
+	}
+
+	BOOST_REQUIRE_EQUAL(target.written.size(), 4000u);
+	BOOST_CHECK(target.handoffs < 4000);
+
+	map<string, int> next;
+	for(const auto& entry : target.written)
+		BOOST_CHECK(entry.message == to_wstring(next[entry.facility]++));
+}
+
+BOOST_AUTO_TEST_CASE(flush_drains_shards) {
+	CollectingLog target;
+	ShardedLog::Options options;
+	options.drainInterval = chrono::seconds{10};
+	options.ordering = ShardedLog::RELAXED;
+	ShardedLog sharded(target, options);
+	Logger logger(sharded, "SHARD_TEST");
+
+	logger << "pending" << end_entry;
+	sharded.flush();
+	BOOST_REQUIRE_EQUAL(target.written.size(), 1u);
+	BOOST_CHECK(target.written[0].message == L"pending");
+}
+
+BOOST_AUTO_TEST_CASE(full_shard_drops_when_asked) {
+	CollectingLog target;
+	ShardedLog::Options options;
+	options.shards = 1;
+	options.shardCapacity = 10;
+	options.drainInterval = chrono::seconds{10};
+	options.dropWhenFull = true;
+	ShardedLog sharded(target, options);
+	sharded.enableStats();
+	Logger logger(sharded, "SHARD_TEST");
+
+	for(int i=0; i<15; ++i)
+		logger << i << end_entry;
+	sharded.flush();
+
+	BOOST_CHECK_EQUAL(target.written.size(), 10u);
+	BOOST_CHECK_EQUAL(sharded.getStats()->snapshot().dropped, 5u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
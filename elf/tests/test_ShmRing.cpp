@@ -0,0 +1,161 @@
+/*
+ * test_ShmRing.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Georgios Dimitriadis
+ *
+ * Copyright (c) 2026, Georgios Dimitriadis
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <boost/test/unit_test.hpp>
+#include "../Logger.h"
+#include "../ShmRing.h"
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+using namespace std;
+using namespace elf;
+
+BOOST_AUTO_TEST_SUITE(test_shm_ring)
+
+struct temp_ring {
+	temp_ring() : name("elf_test_ring_" + to_string(::getpid())) { ShmRing::unlink(name); }
+	~temp_ring() { ShmRing::unlink(name); }
+	const string name;
+};
+
+BOOST_AUTO_TEST_CASE(push_and_drain_across_wrap) {
+	temp_ring tmp;
+	ShmRing producer(tmp.name, 4096);
+	ShmRing consumer(tmp.name);
+	BOOST_CHECK_EQUAL(consumer.capacity(), 4096u);
+
+	int expected = 0;
+	for(int round=0; round<50; ++round) {
+		for(int i=0; i<10; ++i) {
+			string record = "record " + to_string(round*10 + i);
+			BOOST_REQUIRE(producer.push(record.data(), record.size()));
+		}
+		consumer.drain([&](const char* data, size_t size) {
+			BOOST_CHECK_EQUAL(string(data, size), "record " + to_string(expected++));
+		});
+	}
+	BOOST_CHECK_EQUAL(expected, 500);
+	BOOST_CHECK_EQUAL(producer.dropped(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(full_ring_drops_instead_of_blocking) {
+	temp_ring tmp;
+	ShmRing ring(tmp.name, 4096);
+	string record(100, 'x');
+	int pushed = 0;
+	while(ring.push(record.data(), record.size()))
+		++pushed;
+
+	BOOST_CHECK(pushed > 30);
+	BOOST_CHECK_EQUAL(ring.dropped(), 1u);
+	BOOST_CHECK_EQUAL(ring.drain([](const char*, size_t) { }), static_cast<size_t>(pushed));
+	BOOST_CHECK(ring.push(record.data(), record.size()));
+}
+
+BOOST_AUTO_TEST_CASE(entries_survive_crashed_producer_process) {
+	temp_ring tmp;
+	pid_t child = ::fork();
+	BOOST_REQUIRE(child >= 0);
+	if(child == 0) {
+		ShmLog log(tmp.name, 64*1024);
+		Logger logger(log, "SHM_TEST");
+		for(int i=0; i<100; ++i)
+			logger << "entry " << i << end_entry;
+		::_exit(0); // no destructors, as if the process crashed
+	}
+
+	int status = 0;
+	::waitpid(child, &status, 0);
+	BOOST_REQUIRE(WIFEXITED(status));
+
+	ShmRing collector(tmp.name);
+	vector<string> lines;
+	collector.drain([&](const char* data, size_t size) { lines.emplace_back(data, size); });
+	BOOST_REQUIRE_EQUAL(lines.size(), 100u);
+	BOOST_CHECK(lines[0].find("|SHM_TEST|entry 0\n") != string::npos);
+	BOOST_CHECK(lines[99].find("|SHM_TEST|entry 99\n") != string::npos);
+}
+
+BOOST_AUTO_TEST_CASE(second_producer_is_refused) {
+	temp_ring tmp;
+	{
+		ShmRing producer(tmp.name, 4096);
+		BOOST_CHECK_THROW(ShmRing(tmp.name, 4096), runtime_error);
+		ShmRing consumer(tmp.name);
+	}
+	ShmRing next(tmp.name, 4096);
+	BOOST_CHECK(next.push("after", 5));
+}
+
+BOOST_AUTO_TEST_CASE(second_consumer_is_refused) {
+	temp_ring tmp;
+	ShmRing producer(tmp.name, 4096);
+	{
+		ShmRing consumer(tmp.name);
+		BOOST_CHECK_THROW(ShmRing(tmp.name), runtime_error);
+	}
+	ShmRing next(tmp.name);
+	BOOST_CHECK(producer.push("after", 5));
+	BOOST_CHECK_EQUAL(next.drain([](const char*, size_t) { }), static_cast<size_t>(1));
+}
+
+BOOST_AUTO_TEST_CASE(rewound_records_are_read_again) {
+	temp_ring tmp;
+	ShmRing producer(tmp.name, 4096);
+	ShmRing consumer(tmp.name);
+	BOOST_REQUIRE(producer.push("one", 3));
+	BOOST_REQUIRE(producer.push("two", 3));
+	vector<string> seen;
+	auto collect = [&](const char* data, size_t size) { seen.emplace_back(data, size); };
+
+	BOOST_CHECK_EQUAL(consumer.read(collect), static_cast<size_t>(2));
+	BOOST_CHECK_EQUAL(consumer.read(collect), static_cast<size_t>(0));
+	consumer.rewind();
+	BOOST_CHECK_EQUAL(consumer.read(collect), static_cast<size_t>(2));
+	consumer.commit();
+	consumer.rewind();
+	BOOST_CHECK_EQUAL(consumer.read(collect), static_cast<size_t>(0));
+	BOOST_REQUIRE_EQUAL(seen.size(), static_cast<size_t>(4));
+	BOOST_CHECK_EQUAL(seen[2], "one");
+	BOOST_CHECK_EQUAL(seen[3], "two");
+}
+
+BOOST_AUTO_TEST_CASE(ring_never_set_up_is_refused) {
+	temp_ring tmp;
+	int fd = ::shm_open(("/" + tmp.name).c_str(), O_RDWR|O_CREAT|O_EXCL, 0600);
+	BOOST_REQUIRE(fd >= 0);
+	BOOST_REQUIRE(::ftruncate(fd, 64*1024) == 0);
+	::close(fd);
+	BOOST_CHECK_THROW(ShmRing(tmp.name), runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(open_missing_ring_throws) {
+	BOOST_CHECK_THROW(ShmRing("elf_test_ring_that_does_not_exist"), system_error);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,291 @@
+/*
+ * test_SocketLog.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Georgios Dimitriadis
+ *
+ * Copyright (c) 2026, Georgios Dimitriadis
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <boost/test/unit_test.hpp>
+#include "../Logger.h"
+#include "../SocketLog.h"
+#include <cstring>
+#include <thread>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+using namespace std;
+using namespace elf;
+
+BOOST_AUTO_TEST_SUITE(test_socket_log)
+
+// Accepts connections one after another and keeps everything received.
+class Collector {
+public:
+	explicit Collector(const string& unixPath) : _done(false), _client(-1) {
+		::unlink(unixPath.c_str());
+		_fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+		sockaddr_un addr;
+		memset(&addr, 0, sizeof(addr));
+		addr.sun_family = AF_UNIX;
+		strncpy(addr.sun_path, unixPath.c_str(), sizeof(addr.sun_path) - 1);
+		BOOST_REQUIRE(::bind(_fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) == 0);
+		start();
+	}
+
+	Collector() : _done(false), _client(-1) {
+		_fd = ::socket(AF_INET, SOCK_STREAM, 0);
+		sockaddr_in addr;
+		memset(&addr, 0, sizeof(addr));
+		addr.sin_family = AF_INET;
+		addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+		BOOST_REQUIRE(::bind(_fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) == 0);
+		socklen_t length = sizeof(addr);
+		::getsockname(_fd, reinterpret_cast<sockaddr*>(&addr), &length);
+		port = ntohs(addr.sin_port);
+		start();
+	}
+
+	~Collector() {
+		_done = true;
+		::shutdown(_fd, SHUT_RDWR);
+		{
+			lock_guard<mutex> lock(_mutex);
+			if(_client >= 0)
+				::shutdown(_client, SHUT_RDWR);
+		}
+		_thread.join();
+		::close(_fd);
+	}
+
+	string received() {
+		lock_guard<mutex> lock(_mutex);
+		return _received;
+	}
+
+	bool waitFor(size_t bytes) {
+		for(int i=0; i<500 && received().size() < bytes; ++i)
+			this_thread::sleep_for(chrono::milliseconds{10});
+		return received().size() >= bytes;
+	}
+
+	int port;
+
+private:
+	void start() {
+		BOOST_REQUIRE(::listen(_fd, 4) == 0);
+		_thread = thread([this] {
+			while(!_done) {
+				int client = ::accept(_fd, nullptr, nullptr);
+				if(client < 0)
+					return;
+				{
+					lock_guard<mutex> lock(_mutex);
+					_client = client;
+				}
+				char buffer[4096];
+				ssize_t n;
+				while((n = ::read(client, buffer, sizeof(buffer))) > 0) {
+					lock_guard<mutex> lock(_mutex);
+					_received.append(buffer, static_cast<size_t>(n));
+				}
+				lock_guard<mutex> lock(_mutex);
+				_client = -1;
+				::close(client);
+			}
+		});
+	}
+
+	int _fd;
+	atomic<bool> _done;
+	int _client;
+	mutex _mutex;
+	string _received;
+	thread _thread;
+};
+
+vector<string> split_lines(const string& text) {
+	vector<string> lines;
+	size_t begin = 0;
+	for(size_t end; (end = text.find('\n', begin)) != string::npos; begin = end + 1)
+		lines.push_back(text.substr(begin, end - begin));
+	return lines;
+}
+
+bool ends_with(const string& str, const string& suffix) {
+	return str.size() >= suffix.size() && str.compare(str.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
+BOOST_AUTO_TEST_CASE(newline_frames_over_unix_socket) {
+	const string path = "/tmp/elf_test_socket_log.sock";
+	Collector collector(path);
+	{
+		SocketLog log("unix:" + path);
+		Logger logger(log, "SOCKET_TEST");
+		for(int i=0; i<1000; ++i)
+			logger << "entry " << i << end_entry;
+		log.flush();
+		BOOST_CHECK_EQUAL(log.buffered(), 0u);
+	}
+
+	auto lines = split_lines(collector.received());
+	BOOST_REQUIRE_EQUAL(lines.size(), 1000u);
+	for(int i=0; i<1000; ++i)
+		BOOST_CHECK(ends_with(lines[static_cast<size_t>(i)], "|SOCKET_TEST|entry " + to_string(i)));
+	::unlink(path.c_str());
+}
+
+BOOST_AUTO_TEST_CASE(length_prefixed_frames_over_tcp) {
+	Collector collector;
+	SocketLog::Options options;
+	options.framing = SocketLog::LENGTH_PREFIXED;
+	{
+		SocketLog log("tcp:127.0.0.1:" + to_string(collector.port), INFO, options);
+		Logger logger(log, "SOCKET_TEST");
+		logger << "first" << end_entry;
+		logger << "line\nbreak" << end_entry;
+	}
+
+	BOOST_REQUIRE(collector.waitFor(1));
+	string data = collector.received();
+	vector<string> frames;
+	for(size_t pos = 0; pos + 4 <= data.size(); ) {
+		const unsigned char* header = reinterpret_cast<const unsigned char*>(data.data() + pos);
+		size_t length = (size_t{header[0]} << 24) | (size_t{header[1]} << 16) | (size_t{header[2]} << 8) | header[3];
+		frames.push_back(data.substr(pos + 4, length));
+		pos += 4 + length;
+	}
+	BOOST_REQUIRE_EQUAL(frames.size(), 2u);
+	BOOST_CHECK(ends_with(frames[0], "|first"));
+	BOOST_CHECK(ends_with(frames[1], "|line\nbreak"));
+}
+
+BOOST_AUTO_TEST_CASE(buffers_while_collector_is_down) {
+	const string path = "/tmp/elf_test_socket_log_late.sock";
+	::unlink(path.c_str());
+	SocketLog::Options options;
+	options.reconnectDelay = chrono::milliseconds{5};
+	options.maxReconnectDelay = chrono::milliseconds{20};
+	SocketLog log("unix:" + path, INFO, options);
+	Logger logger(log, "SOCKET_TEST");
+	for(int i=0; i<100; ++i)
+		logger << "early " << i << end_entry;
+	BOOST_CHECK(!log.isConnected());
+	BOOST_CHECK(log.buffered() > 0);
+
+	Collector collector(path);
+	log.flush();
+	BOOST_CHECK_EQUAL(log.buffered(), 0u);
+	BOOST_REQUIRE(collector.waitFor(100 * 40));
+	BOOST_CHECK_EQUAL(split_lines(collector.received()).size(), 100u);
+	BOOST_CHECK_EQUAL(log.dropped(), 0u);
+	::unlink(path.c_str());
+}
+
+BOOST_AUTO_TEST_CASE(full_buffer_drops_oldest) {
+	const string path = "/tmp/elf_test_socket_log_full.sock";
+	::unlink(path.c_str());
+	SocketLog::Options options;
+	options.bufferBytes = 1000;
+	options.whenFull = SocketLog::DROP_OLDEST;
+	options.reconnectDelay = chrono::milliseconds{5};
+	options.maxReconnectDelay = chrono::milliseconds{20};
+	SocketLog log("unix:" + path, INFO, options);
+	log.enableStats();
+	Logger logger(log, "SOCKET_TEST");
+	for(int i=0; i<100; ++i)
+		logger << "entry " << i << end_entry;
+	BOOST_CHECK(log.buffered() <= 1000u);
+
+	Collector collector(path);
+	log.flush();
+	for(int i=0; i<500 && !ends_with(collector.received(), "|entry 99\n"); ++i)
+		this_thread::sleep_for(chrono::milliseconds{10});
+	auto lines = split_lines(collector.received());
+	BOOST_REQUIRE(!lines.empty());
+	BOOST_CHECK(lines.size() < 100u);
+	BOOST_CHECK(ends_with(lines.back(), "|entry 99"));
+	BOOST_CHECK_EQUAL(log.dropped(), 100u - lines.size());
+	BOOST_CHECK_EQUAL(log.getStats()->snapshot().dropped, log.dropped());
+	::unlink(path.c_str());
+}
+
+BOOST_AUTO_TEST_CASE(blocking_log_drops_oversized_frame) {
+	const string path = "/tmp/elf_test_socket_log_oversized.sock";
+	::unlink(path.c_str());
+	Collector collector(path);
+	SocketLog::Options options;
+	options.bufferBytes = 100;
+	options.whenFull = SocketLog::BLOCK;
+	SocketLog log("unix:" + path, INFO, options);
+	log.enableStats();
+	Logger logger(log, "SOCKET_TEST");
+	logger << string(200, 'x') << end_entry;
+	logger << "small" << end_entry;
+	log.flush();
+	for(int i=0; i<500 && !ends_with(collector.received(), "|small\n"); ++i)
+		this_thread::sleep_for(chrono::milliseconds{10});
+
+	BOOST_CHECK_EQUAL(split_lines(collector.received()).size(), 1u);
+	BOOST_CHECK_EQUAL(log.dropped(), 1u);
+	BOOST_CHECK_EQUAL(log.getStats()->snapshot().bytes, collector.received().size());
+	::unlink(path.c_str());
+}
+
+BOOST_AUTO_TEST_CASE(teardown_does_not_wait_for_stalled_collector) {
+	const string path = "/tmp/elf_test_socket_log_stalled.sock";
+	::unlink(path.c_str());
+	// Listens but never reads, so send blocks once the socket buffer is full.
+	int listener = ::socket(AF_UNIX, SOCK_STREAM, 0);
+	sockaddr_un addr;
+	memset(&addr, 0, sizeof(addr));
+	addr.sun_family = AF_UNIX;
+	strncpy(addr.sun_path, path.c_str(), sizeof(addr.sun_path) - 1);
+	BOOST_REQUIRE(::bind(listener, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) == 0);
+	BOOST_REQUIRE(::listen(listener, 4) == 0);
+
+	auto start = chrono::steady_clock::now();
+	{
+		SocketLog::Options options;
+		options.flushTimeout = chrono::milliseconds{50};
+		options.ioTimeout = chrono::seconds{30};
+		SocketLog log("unix:" + path, INFO, options);
+		Logger logger(log, "SOCKET_TEST");
+		const string text(1000, 'x');
+		for(int i=0; i<2000; ++i)
+			logger << text << end_entry;
+		for(int i=0; i<500 && !log.isConnected(); ++i)
+			this_thread::sleep_for(chrono::milliseconds{10});
+		BOOST_CHECK(log.isConnected());
+	}
+	BOOST_CHECK(chrono::steady_clock::now() - start < chrono::seconds{5});
+	::close(listener);
+	::unlink(path.c_str());
+}
+
+BOOST_AUTO_TEST_CASE(rejects_malformed_address) {
+	BOOST_CHECK_THROW(SocketLog("udp:localhost:514"), invalid_argument);
+	BOOST_CHECK_THROW(SocketLog("tcp:localhost"), invalid_argument);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,134 @@
+/*
+ * test_Span.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Georgios Dimitriadis
+ *
+ * Copyright (c) 2026, Georgios Dimitriadis
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <boost/test/unit_test.hpp>
+#include <boost/property_tree/ptree.hpp>
+#include <boost/property_tree/json_parser.hpp>
+#include "../Logger.h"
+#include "../Span.h"
+#include "../TraceEventLog.h"
+#include <cstdio>
+#include <thread>
+#include <unistd.h>
+
+using namespace std;
+using namespace elf;
+
+BOOST_AUTO_TEST_SUITE(test_span)
+
+struct RecordingLog : public ILog {
+	RecordingLog() : ILog(DEBUG) { }
+
+	vector<Entry> entries;
+	vector<size_t> handed;
+
+	void flush() override { }
+protected:
+	void addEntries(const Entry* batch, size_t count) override {
+		handed.push_back(count);
+		entries.insert(entries.end(), batch, batch + count);
+	}
+	void addEntry(const Entry& entry) override { addEntries(&entry, 1); }
+};
+
+BOOST_AUTO_TEST_CASE(nested_spans_are_handed_over_when_outermost_ends) {
+	RecordingLog log;
+	Logger logger(log, "SPAN_TEST");
+	{
+		Span outer(logger, "outer");
+		{
+			Span inner(logger, "inner");
+			this_thread::sleep_for(chrono::milliseconds{2});
+		}
+		BOOST_CHECK(log.entries.empty());
+	}
+
+	BOOST_REQUIRE_EQUAL(log.entries.size(), 2u);
+	BOOST_REQUIRE_EQUAL(log.handed.size(), 1u);
+
+	SpanInfo inner, outer;
+	BOOST_REQUIRE(log.entries[0].get<SpanTag>(inner));
+	BOOST_REQUIRE(log.entries[1].get<SpanTag>(outer));
+	BOOST_CHECK_EQUAL(inner.name, "inner");
+	BOOST_CHECK_EQUAL(outer.name, "outer");
+	BOOST_CHECK_EQUAL(inner.thread, outer.thread);
+	BOOST_CHECK(log.entries[1].time <= log.entries[0].time);
+	BOOST_CHECK(inner.end <= outer.end);
+	BOOST_CHECK(inner.end - log.entries[0].time >= chrono::milliseconds{2});
+	BOOST_CHECK(log.entries[0].facility == "SPAN_TEST");
+	BOOST_CHECK(log.entries[0].message.find(L"inner took ") == 0);
+}
+
+BOOST_AUTO_TEST_CASE(disabled_span_records_nothing) {
+	RecordingLog log;
+	Logger logger(log, "SPAN_TEST.QUIET");
+	FacilityTree::instance().setThreshold("SPAN_TEST.QUIET", INFO);
+	{
+		ELF_SPAN(logger, "ignored");
+	}
+	FacilityTree::instance().clearThreshold("SPAN_TEST.QUIET");
+	BOOST_CHECK(log.entries.empty());
+}
+
+struct temp_trace {
+	temp_trace() : path("/tmp/elf_test_" + to_string(::getpid()) + "_trace.json") { }
+	~temp_trace() { ::remove(path.c_str()); }
+	const string path;
+};
+
+BOOST_AUTO_TEST_CASE(trace_event_log_writes_valid_json) {
+	temp_trace file;
+	const string& path = file.path;
+	{
+		TraceEventLog trace(path);
+		Logger logger(trace, "SPAN_TEST");
+		{
+			Span request(logger, "handle \"request\"");
+			logger << INFO << "halfway" << end_entry;
+			Span parse(logger, "parse");
+		}
+	}
+
+	boost::property_tree::ptree root;
+	boost::property_tree::read_json(path, root);
+
+	BOOST_REQUIRE_EQUAL(root.size(), 3u);
+	vector<boost::property_tree::ptree> events;
+	for(const auto& child : root)
+		events.push_back(child.second);
+
+	BOOST_CHECK_EQUAL(events[0].get<string>("name"), "halfway");
+	BOOST_CHECK_EQUAL(events[0].get<string>("ph"), "i");
+	BOOST_CHECK_EQUAL(events[0].get<string>("args.severity"), "INFO");
+	BOOST_CHECK_EQUAL(events[1].get<string>("name"), "parse");
+	BOOST_CHECK_EQUAL(events[2].get<string>("name"), "handle \"request\"");
+	BOOST_CHECK_EQUAL(events[2].get<string>("ph"), "X");
+	BOOST_CHECK_EQUAL(events[2].get<string>("cat"), "SPAN_TEST");
+	BOOST_CHECK(events[2].get<double>("dur") >= events[1].get<double>("dur"));
+	BOOST_CHECK_EQUAL(events[1].get<long>("tid"), events[2].get<long>("tid"));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,179 @@
+/*
+ * elf_collector.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Georgios Dimitriadis
+ *
+ * Copyright (c) 2026, Georgios Dimitriadis
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+/*
+ * Drains elf shared memory log rings (see ShmLog) into files.
+ *
+ *   elf_collector [--once] [--unlink] [--interval <ms>] <output-dir> <ring>...
+ *
+ * Every ring is written to <output-dir>/<ring>.log. A ring name ending in
+ * '*' is a prefix: rings matching it in /dev/shm are picked up as they
+ * appear, so several processes on a host can share one collector.
+ */
+#include "../ShmRing.h"
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <set>
+#include <thread>
+#include <vector>
+#include <dirent.h>
+
+using namespace std;
+using namespace elf;
+
+namespace {
+
+atomic<bool> stopping(false);
+
+void on_signal(int) {
+	stopping = true;
+}
+
+struct collected_ring {
+	unique_ptr<ShmRing> ring;
+	unique_ptr<ofstream> out;
+	uint64_t reportedDrops;
+};
+
+vector<string> expand(const vector<string>& patterns) {
+	vector<string> names;
+	for(const auto& pattern : patterns) {
+		if(pattern.empty() || pattern.back() != '*') {
+			names.push_back(pattern);
+			continue;
+		}
+
+		string prefix = pattern.substr(0, pattern.size() - 1);
+		if(DIR* dir = ::opendir("/dev/shm")) {
+			while(dirent* ent = ::readdir(dir)) {
+				if(strncmp(ent->d_name, prefix.c_str(), prefix.size()) == 0)
+					names.push_back(ent->d_name);
+			}
+			::closedir(dir);
+		}
+	}
+	return names;
+}
+
+}
+
+int main(int argc, char* argv[]) {
+	bool once = false;
+	bool unlinkRings = false;
+	chrono::milliseconds interval{10};
+	vector<string> args;
+	for(int i=1; i<argc; ++i) {
+		string arg = argv[i];
+		if(arg == "--once")
+			once = true;
+		else if(arg == "--unlink")
+			unlinkRings = true;
+		else if(arg == "--interval" && i+1 < argc)
+			interval = chrono::milliseconds{atoi(argv[++i])};
+		else
+			args.push_back(arg);
+	}
+
+	if(args.size() < 2) {
+		cerr << "usage: " << argv[0] << " [--once] [--unlink] [--interval <ms>] <output-dir> <ring>..." << endl;
+		return 2;
+	}
+
+	const string outputDir = args[0];
+	const vector<string> patterns(args.begin() + 1, args.end());
+	signal(SIGINT, on_signal);
+	signal(SIGTERM, on_signal);
+
+	map<string, collected_ring> rings;
+	set<string> unwritable;
+	bool last = false;
+	while(!last) {
+		last = once || stopping;
+
+		for(const auto& name : expand(patterns)) {
+			if(rings.count(name))
+				continue;
+			unique_ptr<ofstream> out(new ofstream(outputDir + "/" + name + ".log", ios::app|ios::binary));
+			if(!out->is_open()) {
+				// Leave the ring alone and retry on the next pass.
+				if(unwritable.insert(name).second || once)
+					cerr << name << ": cannot open " << outputDir << "/" << name << ".log" << endl;
+				continue;
+			}
+			try {
+				collected_ring collected;
+				collected.ring.reset(new ShmRing(name));
+				collected.out = std::move(out);
+				collected.reportedDrops = 0;
+				rings[name] = std::move(collected);
+				unwritable.erase(name);
+			} catch(const exception& e) {
+				if(once)
+					cerr << e.what() << endl;
+			}
+		}
+
+		size_t drained = 0;
+		for(auto& entry : rings) {
+			collected_ring& collected = entry.second;
+			// Records are only freed once they are safely in the file.
+			size_t records = collected.ring->read([&](const char* data, size_t size) {
+				collected.out->write(data, static_cast<streamsize>(size));
+			});
+			collected.out->flush();
+			if(collected.out->good()) {
+				collected.ring->commit();
+				drained += records;
+			} else {
+				cerr << entry.first << ": cannot write " << outputDir << "/" << entry.first << ".log, keeping " << records << " entries in the ring" << endl;
+				collected.out->clear();
+				collected.ring->rewind();
+			}
+			uint64_t drops = collected.ring->dropped();
+			if(drops != collected.reportedDrops) {
+				cerr << entry.first << ": " << drops - collected.reportedDrops << " entries dropped" << endl;
+				collected.reportedDrops = drops;
+			}
+		}
+
+		if(!drained && !last)
+			this_thread::sleep_for(interval);
+	}
+
+	if(unlinkRings) {
+		for(const auto& entry : rings)
+			ShmRing::unlink(entry.first);
+	}
+	return 0;
+}
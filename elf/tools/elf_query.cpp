@@ -0,0 +1,132 @@
+/*
+ * elf_query.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Georgios Dimitriadis
+ *
+ * Copyright (c) 2026, Georgios Dimitriadis
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+/*
+ * Prints the lines of an IndexedFileLog in a time range, using the sidecar
+ * index to read only the blocks that can contain matches.
+ *
+ *   elf_query <log> <from> <to> [<max-severity>] [<facility>]
+ *
+ * <from> and <to> are seconds since the epoch (fractions allowed),
+ * <max-severity> a name such as ERROR. Lines are matched exactly after the
+ * index narrowed the blocks down.
+ */
+#include "../IndexedFileLog.h"
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <limits>
+
+using namespace std;
+using namespace elf;
+
+namespace {
+
+bool parse_severity(const string& name, Severity& severity) {
+	for(int level = EMERGENCY; level <= DEBUG; ++level) {
+		if(to_string(static_cast<Severity>(level)) == name) {
+			severity = static_cast<Severity>(level);
+			return true;
+		}
+	}
+	return false;
+}
+
+int64_t to_nanos(const char* seconds) {
+	double nanos = atof(seconds) * 1e9;
+	if(nanos >= static_cast<double>(numeric_limits<int64_t>::max()))
+		return numeric_limits<int64_t>::max();
+	if(nanos <= static_cast<double>(numeric_limits<int64_t>::min()))
+		return numeric_limits<int64_t>::min();
+	return static_cast<int64_t>(nanos);
+}
+
+// Lines look like "|SEVERITY|secs.millis|facility|message".
+bool matches(const string& line, int64_t from, int64_t to, Severity maxSeverity, const string& facility) {
+	string::size_type sevEnd = line.find('|', 1);
+	string::size_type timeEnd = line.find('|', sevEnd + 1);
+	string::size_type facilityEnd = line.find('|', timeEnd + 1);
+	if(line.empty() || facilityEnd == string::npos)
+		return false;
+
+	Severity severity;
+	if(!parse_severity(line.substr(1, sevEnd - 1), severity) || severity > maxSeverity)
+		return false;
+
+	int64_t time = to_nanos(line.substr(sevEnd + 1, timeEnd - sevEnd - 1).c_str());
+	// Lines only carry milliseconds, so allow for the truncation.
+	if(time + 1000000 < from || time > to)
+		return false;
+
+	string lineFacility = line.substr(timeEnd + 1, facilityEnd - timeEnd - 1);
+	return facility.empty() || lineFacility == facility ||
+			lineFacility.compare(0, facility.size() + 1, facility + ".") == 0;
+}
+
+}
+
+int main(int argc, char* argv[]) {
+	if(argc < 4) {
+		cerr << "usage: " << argv[0] << " <log> <from> <to> [<max-severity>] [<facility>]" << endl;
+		return 2;
+	}
+
+	const string path = argv[1];
+	const int64_t from = to_nanos(argv[2]);
+	const int64_t to = to_nanos(argv[3]);
+	Severity maxSeverity = DEBUG;
+	if(argc > 4 && !parse_severity(argv[4], maxSeverity)) {
+		cerr << "unknown severity " << argv[4] << endl;
+		return 2;
+	}
+	const string facility = argc > 5 ? argv[5] : "";
+
+	try {
+		LogIndex index(path);
+		ifstream log(path, ios::binary);
+		string block;
+		for(const auto& selected : index.select(from, to, maxSeverity, facility)) {
+			block.resize(selected.size);
+			log.seekg(static_cast<streamoff>(selected.offset));
+			log.read(&block[0], static_cast<streamsize>(block.size()));
+			block.resize(static_cast<size_t>(log.gcount()));
+			log.clear();
+
+			string::size_type begin = 0;
+			for(string::size_type end = block.find('\n'); end != string::npos; end = block.find('\n', begin)) {
+				string line = block.substr(begin, end - begin);
+				if(matches(line, from, to, maxSeverity, facility))
+					cout << line << '\n';
+				begin = end + 1;
+			}
+		}
+	} catch(const exception& e) {
+		cerr << e.what() << endl;
+		return 1;
+	}
+	return 0;
+}
@@ -0,0 +1,350 @@
+/*
+ * elf_replay.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Georgios Dimitriadis
+ *
+ * Copyright (c) 2026, Georgios Dimitriadis
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+/*
+ * Load generator for sizing sinks: replays a captured log, or a synthetic
+ * mix of facilities, severities and message lengths, through real Loggers
+ * and sinks from several threads.
+ *
+ *   elf_replay [options] <sink>
+ *
+ * Sinks:
+ *   null                  discards entries after formatting
+ *   stream:<path>         StreamLog on an ofstream
+ *   file:<path>           FileLog
+ *   async:<path>          AsyncLog in front of a FileLog
+ *   sharded:<path>        ShardedLog in front of a FileLog
+ *   compressed:<path>     CompressedFileLog with zlib
+ *   shm:<ring>            ShmLog
+ *   syslog                SysLog
+ *
+ * Options:
+ *   --input <log>         replay the lines of a StreamLog/FileLog file
+ *   --facilities a,b      synthetic facilities (default "replay")
+ *   --severities S:w,...  synthetic severity weights (default INFO:100)
+ *   --length min:max      synthetic message length (default 40:120)
+ *   --threads <n>         logging threads (default 1)
+ *   --rate <n>            entries per second over all threads, open loop:
+ *                         every call has a scheduled start and its latency
+ *                         is measured from there, so falling behind shows
+ *                         up as latency instead of a lower offered rate.
+ *                         0 (default) logs as fast as possible.
+ *   --duration <s>        seconds to run (default 5)
+ *
+ * Prints a CSV header and one row. Latency percentiles are upper bounds of
+ * power of two buckets. The backlog is the number of entries accepted by
+ * a queueing front (async, sharded) but not yet by the sink behind it,
+ * sampled every 10 ms.
+ */
+#include "../Logger.h"
+#include "../StreamLog.h"
+#include "../SysLog.h"
+#include "../FileLog.h"
+#include "../AsyncLog.h"
+#include "../ShardedLog.h"
+#include "../CompressedFileLog.h"
+#include "../ShmRing.h"
+#include <atomic>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+using namespace std;
+using namespace elf;
+
+namespace {
+
+struct NullLog : public ILog {
+	NullLog() : ILog(DEBUG) { }
+	void flush() override { }
+protected:
+	void addEntry(const Entry& entry) override {
+		_line.clear();
+		format_entry(_line, entry);
+	}
+private:
+	string _line;
+};
+
+struct record {
+	Severity severity;
+	string facility;
+	logstring message;
+};
+
+struct sink_chain {
+	vector<unique_ptr<ILog>> logs;	// the sink first, then the fronts wrapping it
+	unique_ptr<ofstream> stream;
+
+	ILog& front() { return *logs.back(); }
+
+	uint64_t backlog() const {
+		if(logs.size() < 2)
+			return 0;
+		auto front = logs.back()->getStats()->snapshot();
+		auto sink = logs.front()->getStats()->snapshot();
+		uint64_t done = sink.accepted + sink.filtered + front.dropped;
+		return front.accepted > done ? front.accepted - done : 0;
+	}
+};
+
+vector<string> split(const string& str, char separator) {
+	vector<string> parts;
+	stringstream ss(str);
+	for(string part; getline(ss, part, separator); )
+		parts.push_back(part);
+	return parts;
+}
+
+bool parse_severity(const string& name, Severity& severity) {
+	for(int level = EMERGENCY; level <= DEBUG; ++level) {
+		if(to_string(static_cast<Severity>(level)) == name) {
+			severity = static_cast<Severity>(level);
+			return true;
+		}
+	}
+	return false;
+}
+
+vector<record> load_capture(const string& path) {
+	vector<record> records;
+	ifstream in(path);
+	for(string line; getline(in, line); ) {
+		// "|SEVERITY|secs.millis|facility|message"
+		vector<string::size_type> bars;
+		for(string::size_type pos = line.find('|'); pos != string::npos && bars.size() < 4; pos = line.find('|', pos + 1))
+			bars.push_back(pos);
+		record r;
+		if(bars.size() < 4 || !parse_severity(line.substr(1, bars[1] - 1), r.severity))
+			continue;
+		r.facility = line.substr(bars[2] + 1, bars[3] - bars[2] - 1);
+		string message = line.substr(bars[3] + 1);
+		r.message = logstring(message.begin(), message.end());
+		records.push_back(r);
+	}
+	return records;
+}
+
+vector<record> synthesize(const vector<string>& facilities, const vector<pair<Severity, unsigned>>& severities,
+		size_t minLength, size_t maxLength) {
+	mt19937 rng(42);
+	vector<unsigned> weights;
+	for(const auto& severity : severities)
+		weights.push_back(severity.second);
+	discrete_distribution<size_t> pickSeverity(weights.begin(), weights.end());
+	uniform_int_distribution<size_t> pickFacility(0, facilities.size() - 1);
+	uniform_int_distribution<size_t> pickLength(minLength, maxLength);
+	uniform_int_distribution<int> pickChar('a', 'z');
+
+	vector<record> records(4096);
+	for(auto& r : records) {
+		r.severity = severities[pickSeverity(rng)].first;
+		r.facility = facilities[pickFacility(rng)];
+		r.message.resize(pickLength(rng));
+		for(auto& c : r.message)
+			c = static_cast<log_char>(pickChar(rng));
+	}
+	return records;
+}
+
+bool make_sink(const string& spec, sink_chain& chain) {
+	string::size_type colon = spec.find(':');
+	string kind = spec.substr(0, colon);
+	string arg = colon == string::npos ? "" : spec.substr(colon + 1);
+
+	if(kind == "null") {
+		chain.logs.emplace_back(new NullLog);
+	} else if(kind == "stream") {
+		chain.stream.reset(new ofstream(arg));
+		chain.logs.emplace_back(new StreamLog(*chain.stream, DEBUG));
+	} else if(kind == "file") {
+		chain.logs.emplace_back(new FileLog(arg, DEBUG));
+	} else if(kind == "async") {
+		chain.logs.emplace_back(new FileLog(arg, DEBUG));
+		chain.logs.emplace_back(new AsyncLog(*chain.logs.back()));
+	} else if(kind == "sharded") {
+		chain.logs.emplace_back(new FileLog(arg, DEBUG));
+		chain.logs.emplace_back(new ShardedLog(*chain.logs.back()));
+	} else if(kind == "compressed") {
+		chain.logs.emplace_back(new CompressedFileLog(arg, unique_ptr<Codec>(new ZlibCodec), DEBUG));
+	} else if(kind == "shm") {
+		chain.logs.emplace_back(new ShmLog(arg, 64*1024*1024, DEBUG));
+	} else if(kind == "syslog") {
+		chain.logs.emplace_back(new SysLog("elf_replay", DEBUG));
+	} else {
+		return false;
+	}
+
+	for(auto& log : chain.logs)
+		log->enableStats();
+	return true;
+}
+
+int usage(const char* self) {
+	cerr << "usage: " << self << " [--input <log>] [--facilities a,b] [--severities S:w,...] [--length min:max]"
+		 << " [--threads n] [--rate n] [--duration s] <sink>" << endl;
+	return 2;
+}
+
+}
+
+int main(int argc, char* argv[]) {
+	string input, sinkSpec;
+	vector<string> facilities{"replay"};
+	vector<pair<Severity, unsigned>> severities{{INFO, 100}};
+	size_t minLength = 40, maxLength = 120;
+	unsigned threads = 1;
+	double rate = 0;
+	double duration = 5;
+
+	for(int i=1; i<argc; ++i) {
+		string arg = argv[i];
+		bool hasValue = i+1 < argc;
+		if(arg == "--input" && hasValue) {
+			input = argv[++i];
+		} else if(arg == "--facilities" && hasValue) {
+			facilities = split(argv[++i], ',');
+		} else if(arg == "--severities" && hasValue) {
+			severities.clear();
+			for(const auto& weighted : split(argv[++i], ',')) {
+				auto parts = split(weighted, ':');
+				Severity severity;
+				if(parts.size() != 2 || !parse_severity(parts[0], severity))
+					return usage(argv[0]);
+				severities.emplace_back(severity, static_cast<unsigned>(atoi(parts[1].c_str())));
+			}
+		} else if(arg == "--length" && hasValue) {
+			auto parts = split(argv[++i], ':');
+			if(parts.size() != 2)
+				return usage(argv[0]);
+			minLength = static_cast<size_t>(atol(parts[0].c_str()));
+			maxLength = max(minLength, static_cast<size_t>(atol(parts[1].c_str())));
+		} else if(arg == "--threads" && hasValue) {
+			threads = max(1, atoi(argv[++i]));
+		} else if(arg == "--rate" && hasValue) {
+			rate = atof(argv[++i]);
+		} else if(arg == "--duration" && hasValue) {
+			duration = atof(argv[++i]);
+		} else if(sinkSpec.empty() && arg[0] != '-') {
+			sinkSpec = arg;
+		} else {
+			return usage(argv[0]);
+		}
+	}
+	if(sinkSpec.empty() || facilities.empty() || severities.empty())
+		return usage(argv[0]);
+
+	const vector<record> records = input.empty() ?
+			synthesize(facilities, severities, minLength, maxLength) : load_capture(input);
+	if(records.empty()) {
+		cerr << "nothing to replay" << endl;
+		return 1;
+	}
+
+	sink_chain chain;
+	if(!make_sink(sinkSpec, chain))
+		return usage(argv[0]);
+
+	LatencyHistogram latency;
+	atomic<uint64_t> sent(0);
+	atomic<bool> stop(false);
+	uint64_t maxBacklog = 0;
+
+	thread monitor([&] {
+		while(!stop) {
+			maxBacklog = max(maxBacklog, chain.backlog());
+			this_thread::sleep_for(chrono::milliseconds{10});
+		}
+	});
+
+	typedef chrono::steady_clock steady;
+	const auto begin = steady::now();
+	const auto end = begin + chrono::duration_cast<steady::duration>(chrono::duration<double>(duration));
+	vector<thread> workers;
+	for(unsigned t=0; t<threads; ++t) {
+		workers.emplace_back([&, t] {
+			map<string, unique_ptr<Logger>> loggers;
+			const auto interval = rate > 0 ?
+					chrono::duration_cast<steady::duration>(chrono::duration<double>(threads / rate)) : steady::duration::zero();
+			auto scheduled = begin;
+			uint64_t count = 0;
+			// Threads beyond the number of records share them from the start.
+			for(size_t i = t % records.size(); ; i = (i + threads) % records.size()) {
+				auto now = steady::now();
+				if(now >= end)
+					break;
+				if(rate > 0) {
+					if(now < scheduled)
+						this_thread::sleep_until(scheduled);
+				} else {
+					scheduled = now;
+				}
+
+				const record& r = records[i];
+				unique_ptr<Logger>& logger = loggers[r.facility];
+				if(!logger)
+					logger.reset(new Logger(chain.front(), r.facility, INFO));
+				*logger << r.severity << r.message << end_entry;
+
+				latency.record(steady::now() - scheduled);
+				scheduled += interval;
+				++count;
+			}
+			sent += count;
+		});
+	}
+	for(auto& worker : workers)
+		worker.join();
+	const chrono::duration<double> elapsed = steady::now() - begin;
+	stop = true;
+	monitor.join();
+	const uint64_t finalBacklog = chain.backlog();
+	chain.front().flush();
+
+	auto hist = latency.snapshot();
+	uint64_t dropped = 0;
+	for(const auto& log : chain.logs)
+		dropped += log->getStats()->snapshot().dropped;
+
+	cout << "sink,threads,target_rate,achieved_rate,p50_ns,p99_ns,p999_ns,max_ns,max_backlog,final_backlog,dropped" << endl;
+	cout << sinkSpec << "," << threads << "," << static_cast<uint64_t>(rate) << ","
+		 << static_cast<uint64_t>(static_cast<double>(sent.load()) / elapsed.count()) << ","
+		 << hist.percentile(0.5) << "," << hist.percentile(0.99) << "," << hist.percentile(0.999) << ","
+		 << hist.max << "," << maxBacklog << "," << finalBacklog << "," << dropped << endl;
+
+	while(chain.logs.size()) {
+		// Fronts go before the sinks they write to.
+		chain.logs.pop_back();
+	}
+	return 0;
+}
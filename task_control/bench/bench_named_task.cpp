@@ -0,0 +1,104 @@
+/*
+ * bench_named_task.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Georgios Dimitriadis
+ *
+ * Copyright (C) 2026 Georgios Dimitriadis
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ *   The above copyright notice and this permission notice shall be
+ *   included in all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+/*
+ * Start and stop latency of a batch of named tasks, each on a dedicated
+ * thread or on a task_executor sized for all of them.
+ *
+ *   bench_named_task [tasks] [executor stack KB]
+ *
+ * Prints CSV: mode,tasks,setup_ms,start_ms,stop_ms,restart_ms. setup_ms is
+ * the time to create the executor's workers, restart_ms a second start
+ * after the first stop.
+ */
+#include <task_control/task_batch.h>
+#include <task_control/task_executor.h>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+
+using namespace task_control;
+using namespace std;
+
+namespace {
+
+typedef chrono::steady_clock bench_clock;
+
+double ms_since(bench_clock::time_point begin) {
+	return chrono::duration<double, milli>(bench_clock::now() - begin).count();
+}
+
+void idle_task(named_task::init_callback_t init_callback, const stop_token& stop) {
+	init_callback(true);
+	stop.wait();
+}
+
+void report(const char* task) {
+	cerr << "task " << task << " missed its deadline" << endl;
+}
+
+void run(const char* mode, size_t tasks, task_executor* executor, double setup_ms) {
+	const chrono::milliseconds max_wait{60000};
+	auto failure = [](const named_task& task) { report(task.name().c_str()); };
+
+	task_batch batch;
+	for(size_t i=0; i<tasks; ++i) {
+		const string name = "task_" + to_string(i);
+		batch.add(unique_ptr<named_task>{executor ? new named_task{name, idle_task, *executor} : new named_task{name, idle_task}});
+	}
+
+	auto begin = bench_clock::now();
+	batch.start(max_wait, failure);
+	double start_ms = ms_since(begin);
+
+	begin = bench_clock::now();
+	batch.stop(max_wait, failure);
+	double stop_ms = ms_since(begin);
+
+	begin = bench_clock::now();
+	batch.start(max_wait, failure);
+	double restart_ms = ms_since(begin);
+	batch.stop(max_wait, failure);
+
+	cout << mode << "," << tasks << "," << setup_ms << "," << start_ms << "," << stop_ms << "," << restart_ms << endl;
+}
+
+}
+
+int main(int argc, char* argv[]) {
+	const size_t tasks = argc > 1 ? static_cast<size_t>(atol(argv[1])) : 10000;
+	const size_t stack_kb = argc > 2 ? static_cast<size_t>(atol(argv[2])) : 64;
+
+	cout << "mode,tasks,setup_ms,start_ms,stop_ms,restart_ms" << endl;
+	run("dedicated", tasks, nullptr, 0);
+
+	auto begin = bench_clock::now();
+	task_executor executor{tasks, stack_kb * 1024};
+	double setup_ms = ms_since(begin);
+	run("pooled", tasks, &executor, setup_ms);
+	return 0;
+}
@@ -0,0 +1,78 @@
+/*
+ * completion_queue.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Georgios Dimitriadis
+ *
+ * Copyright (C) 2026 Georgios Dimitriadis
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ *   The above copyright notice and this permission notice shall be
+ *   included in all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#ifndef COMPLETION_QUEUE_H_
+#define COMPLETION_QUEUE_H_
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+
+namespace task_control {
+
+/*
+ * Completions reported from the tasks' threads, in the order they happen.
+ * Shared with the listeners handed to named_task, which may fire after the
+ * waiting side gave up, so it is always held by a shared_ptr.
+ */
+class completion_queue {
+public:
+	struct event {
+		std::size_t id;
+		bool success;
+		std::chrono::steady_clock::time_point at;
+	};
+
+	void push(std::size_t id, bool success) {
+		const auto now = std::chrono::steady_clock::now();
+		{
+			std::lock_guard<std::mutex> lock{mutex_};
+			events_.push_back(event{id, success, now});
+		}
+		changed_.notify_one();
+	}
+
+	bool pop(event& next, const std::chrono::steady_clock::time_point& deadline) {
+		std::unique_lock<std::mutex> lock{mutex_};
+		if(!changed_.wait_until(lock, deadline, [this] { return !events_.empty(); }))
+			return false;
+		next = events_.front();
+		events_.pop_front();
+		return true;
+	}
+
+private:
+	std::mutex mutex_;
+	std::condition_variable changed_;
+	std::deque<event> events_;
+};
+
+} /* namespace task_control */
+
+#endif /* COMPLETION_QUEUE_H_ */
@@ -0,0 +1,68 @@
+/*
+ * heartbeat.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Georgios Dimitriadis
+ *
+ * Copyright (C) 2026 Georgios Dimitriadis
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ *   The above copyright notice and this permission notice shall be
+ *   included in all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#include <task_control/heartbeat.h>
+
+using namespace task_control;
+using namespace std;
+
+namespace {
+
+thread_local heartbeat* current_heartbeat = nullptr;
+
+}
+
+heartbeat::heartbeat()
+	: last_{0},
+	  progress_{0}
+{
+}
+
+void heartbeat::beat() {
+	last_.store(clock_t::now().time_since_epoch().count(), memory_order_relaxed);
+}
+
+void heartbeat::advance(uint64_t n) {
+	progress_.fetch_add(n, memory_order_relaxed);
+	beat();
+}
+
+heartbeat::clock_t::time_point heartbeat::last() const {
+	return clock_t::time_point{clock_t::duration{last_.load(memory_order_relaxed)}};
+}
+
+uint64_t heartbeat::progress() const {
+	return progress_.load(memory_order_relaxed);
+}
+
+heartbeat& heartbeat::current() {
+	thread_local heartbeat unwatched;
+	return current_heartbeat ? *current_heartbeat : unwatched;
+}
+
+void heartbeat::set_current(heartbeat* beating) {
+	current_heartbeat = beating;
+}
@@ -0,0 +1,74 @@
+/*
+ * heartbeat.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Georgios Dimitriadis
+ *
+ * Copyright (C) 2026 Georgios Dimitriadis
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ *   The above copyright notice and this permission notice shall be
+ *   included in all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#ifndef HEARTBEAT_H_
+#define HEARTBEAT_H_
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+namespace task_control {
+
+/*
+ * Liveness published by a running task: the time of its last beat and a
+ * progress counter. Both are relaxed atomics, so a task can beat in its
+ * inner loop and a watchdog can read them without taking any lock.
+ *
+ * named_task beats on start, on init and on exit. In between, the task
+ * function beats through heartbeat::current(), which names the heartbeat
+ * of the task running on the calling thread.
+ */
+class heartbeat {
+public:
+	typedef std::chrono::steady_clock clock_t;
+
+	heartbeat();
+	heartbeat(const heartbeat&) = delete;
+	heartbeat& operator = (const heartbeat&) = delete;
+
+	void beat();
+	// Counts n units of progress and beats.
+	void advance(std::uint64_t n=1);
+
+	clock_t::time_point last() const;
+	std::uint64_t progress() const;
+
+	// Outside a named_task this is a heartbeat of the thread nobody watches.
+	static heartbeat& current();
+
+private:
+	friend class named_task;
+	static void set_current(heartbeat* beating);
+
+	std::atomic<clock_t::rep> last_;
+	std::atomic<std::uint64_t> progress_;
+};
+
+} /* namespace task_control */
+
+#endif /* HEARTBEAT_H_ */
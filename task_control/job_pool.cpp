@@ -0,0 +1,236 @@
+/*
+ * job_pool.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Georgios Dimitriadis
+ *
+ * Copyright (C) 2026 Georgios Dimitriadis
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ *   The above copyright notice and this permission notice shall be
+ *   included in all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#include <task_control/job_pool.h>
+#include <chrono>
+#include <stdexcept>
+
+using namespace task_control;
+using namespace std;
+
+namespace {
+
+const size_t not_a_worker = SIZE_MAX;
+
+thread_local job_pool* current_pool = nullptr;
+thread_local size_t current_worker = not_a_worker;
+
+}
+
+job_group::job_group(job_pool& pool)
+	: pool_(pool),
+	  pending_{0},
+	  forked_{0}
+{
+}
+
+job_group::~job_group() {
+	try {
+		join();
+	} catch (...) {
+	}
+}
+
+void job_group::fork(function<void()> job) {
+	pending_.fetch_add(1);
+	{
+		lock_guard<mutex> lock{wait_mutex_};
+		forked_.fetch_add(1);
+	}
+	changed_.notify_all();
+	// Once submitted the job may run and end the group, so submit last.
+	pool_.submit(new job_pool::job{move(job), this});
+}
+
+void job_group::join() {
+	while(pending_.load(memory_order_acquire)) {
+		const auto forked = forked_.load();
+		if(pool_.run_one())
+			continue;
+		// The timeout covers jobs a failed steal missed while no worker runs.
+		unique_lock<mutex> lock{wait_mutex_};
+		changed_.wait_for(lock, chrono::milliseconds{1}, [&] {
+			return !pending_.load(memory_order_acquire) || forked_.load() != forked;
+		});
+	}
+	// done() may still be notifying.
+	{
+		lock_guard<mutex> lock{wait_mutex_};
+	}
+
+	exception_ptr failure;
+	{
+		lock_guard<mutex> lock{failure_mutex_};
+		swap(failure, failure_);
+	}
+	if(failure)
+		rethrow_exception(failure);
+}
+
+void job_group::done(exception_ptr failure) {
+	if(failure) {
+		lock_guard<mutex> lock{failure_mutex_};
+		if(!failure_)
+			failure_ = failure;
+	}
+	// The joining thread may destroy the group once this lock is released.
+	lock_guard<mutex> lock{wait_mutex_};
+	if(pending_.fetch_sub(1, memory_order_release) == 1)
+		changed_.notify_all();
+}
+
+job_pool::job_pool(size_t workers)
+	: shared_size_{0},
+	  queued_{0},
+	  sleeping_{0},
+	  steals_{0},
+	  stopping_{false}
+{
+	if(!workers)
+		throw invalid_argument("job_pool: needs at least one worker");
+	for(size_t i=0; i<workers; ++i)
+		workers_.emplace_back(new worker);
+}
+
+job_pool::~job_pool() {
+	while(auto left = take(not_a_worker))
+		delete left;
+}
+
+void job_pool::operator () (named_task::init_callback_t init, const stop_token& stop) {
+	{
+		lock_guard<mutex> lock{sleep_mutex_};
+		stopping_ = false;
+	}
+	auto wake_on_stop = stop.on_stop([this] {
+		{
+			lock_guard<mutex> lock{sleep_mutex_};
+			stopping_ = true;
+		}
+		wake_.notify_all();
+	});
+
+	vector<thread> helpers;
+	for(size_t i=1; i<workers_.size(); ++i)
+		helpers.emplace_back(&job_pool::work, this, i);
+	init(true);
+	work(0);
+	for(auto& helper : helpers)
+		helper.join();
+	stop.remove_on_stop(wake_on_stop);
+}
+
+size_t job_pool::size() const {
+	return workers_.size();
+}
+
+uint64_t job_pool::steals() const {
+	return steals_.load(memory_order_relaxed);
+}
+
+void job_pool::submit(job* next) {
+	// Counted first, so that whoever takes it never counts below zero.
+	queued_.fetch_add(1);
+	if(current_pool == this) {
+		workers_[current_worker]->jobs.push(next);
+	} else {
+		lock_guard<mutex> lock{shared_mutex_};
+		shared_.push_back(next);
+		shared_size_.fetch_add(1);
+	}
+	if(sleeping_.load()) {
+		{
+			lock_guard<mutex> lock{sleep_mutex_};
+		}
+		wake_.notify_one();
+	}
+}
+
+job_pool::job* job_pool::take(size_t self) {
+	job* next = nullptr;
+	if(self != not_a_worker)
+		next = workers_[self]->jobs.pop();
+	if(!next && shared_size_.load()) {
+		lock_guard<mutex> lock{shared_mutex_};
+		if(!shared_.empty()) {
+			next = shared_.front();
+			shared_.pop_front();
+			shared_size_.fetch_sub(1);
+		}
+	}
+	for(size_t i=1; !next && i<=workers_.size(); ++i) {
+		const auto victim = (self + i) % workers_.size();
+		if(victim == self)
+			continue;
+		next = workers_[victim]->jobs.steal();
+		if(next)
+			steals_.fetch_add(1, memory_order_relaxed);
+	}
+	if(next)
+		queued_.fetch_sub(1);
+	return next;
+}
+
+bool job_pool::run_one() {
+	auto next = take(current_pool == this ? current_worker : not_a_worker);
+	if(!next)
+		return false;
+	run(next);
+	return true;
+}
+
+void job_pool::run(job* next) {
+	exception_ptr failure;
+	try {
+		next->run();
+	} catch (...) {
+		failure = current_exception();
+	}
+	auto group = next->group;
+	delete next;
+	group->done(failure);
+}
+
+void job_pool::work(size_t self) {
+	current_pool = this;
+	current_worker = self;
+	while(true) {
+		if(auto next = take(self)) {
+			run(next);
+			continue;
+		}
+		unique_lock<mutex> lock{sleep_mutex_};
+		if(stopping_)
+			break;
+		sleeping_.fetch_add(1);
+		wake_.wait(lock, [this] { return stopping_ || queued_.load(); });
+		sleeping_.fetch_sub(1);
+		if(stopping_)
+			break;
+	}
+	current_pool = nullptr;
+	current_worker = not_a_worker;
+}
@@ -0,0 +1,167 @@
+/*
+ * job_pool.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Georgios Dimitriadis
+ *
+ * Copyright (C) 2026 Georgios Dimitriadis
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ *   The above copyright notice and this permission notice shall be
+ *   included in all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#ifndef JOB_POOL_H_
+#define JOB_POOL_H_
+
+#include <task_control/named_task.h>
+#include <task_control/work_stealing_deque.h>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace task_control {
+
+class job_pool;
+
+/*
+ * Jobs forked together and joined together. join() waits until all of
+ * them, and the jobs they forked into the group, have run, running jobs
+ * of the pool itself meanwhile, and then rethrows the first exception a
+ * job threw. With nothing left to run it sleeps until the group is done
+ * or forks another job.
+ */
+class job_group {
+public:
+	explicit job_group(job_pool& pool);
+	job_group(const job_group&) = delete;
+	job_group& operator = (const job_group&) = delete;
+	// Joins, dropping any exception.
+	~job_group();
+
+	void fork(std::function<void()> job);
+	void join();
+
+private:
+	friend class job_pool;
+	void done(std::exception_ptr failure);
+
+	job_pool& pool_;
+	std::atomic<std::size_t> pending_;
+	std::atomic<std::size_t> forked_;
+	std::mutex wait_mutex_;
+	std::condition_variable changed_;
+	std::mutex failure_mutex_;
+	std::exception_ptr failure_;
+};
+
+/*
+ * Short CPU-bound jobs for code running in named tasks. Each worker has a
+ * work-stealing deque: a job forked on a worker goes to the bottom of its
+ * own deque and is run from there, newest first, unless an idle worker
+ * steals it from the top, oldest first. Jobs forked on other threads go
+ * to a shared queue.
+ *
+ * The pool is the task function of a named_task, so it runs while that
+ * task does, on the task's own thread and workers - 1 more:
+ *
+ *   job_pool jobs{4};
+ *   batch.add(unique_ptr<named_task>{new named_task{"jobs", std::ref(jobs)}});
+ *
+ * A thread joining a group runs jobs of the pool until the group is done,
+ * so forking and joining works while the pool is stopped too, if slowly.
+ * The pool must outlive its task.
+ */
+class job_pool {
+public:
+	explicit job_pool(std::size_t workers);
+	job_pool(const job_pool&) = delete;
+	job_pool& operator = (const job_pool&) = delete;
+	~job_pool();
+
+	void operator () (named_task::init_callback_t init, const stop_token& stop);
+
+	// Splits [begin, end) in halves down to at most grain indices and calls
+	// body(first, last) on each part, in parallel.
+	template<typename Body>
+	void parallel_for(std::size_t begin, std::size_t end, std::size_t grain, Body body);
+
+	std::size_t size() const;
+	std::uint64_t steals() const;
+
+private:
+	friend class job_group;
+
+	struct job {
+		std::function<void()> run;
+		job_group* group;
+	};
+
+	struct worker {
+		work_stealing_deque<job*> jobs;
+	};
+
+	template<typename Body>
+	static void split(job_group& group, std::size_t begin, std::size_t end, std::size_t grain, const Body& body);
+
+	void submit(job* next);
+	job* take(std::size_t self);
+	bool run_one();
+	void run(job* next);
+	void work(std::size_t self);
+
+	std::vector<std::unique_ptr<worker>> workers_;
+	std::mutex shared_mutex_;
+	std::deque<job*> shared_;
+	std::atomic<std::size_t> shared_size_;
+	std::atomic<std::size_t> queued_;
+	std::atomic<std::size_t> sleeping_;
+	std::atomic<std::uint64_t> steals_;
+	std::mutex sleep_mutex_;
+	std::condition_variable wake_;
+	bool stopping_;
+};
+
+template<typename Body>
+void job_pool::split(job_group& group, std::size_t begin, std::size_t end, std::size_t grain, const Body& body) {
+	while(end - begin > grain) {
+		const auto middle = begin + (end - begin) / 2;
+		group.fork([&group, middle, end, grain, &body] { split(group, middle, end, grain, body); });
+		end = middle;
+	}
+	if(begin < end)
+		body(begin, end);
+}
+
+template<typename Body>
+void job_pool::parallel_for(std::size_t begin, std::size_t end, std::size_t grain, Body body) {
+	job_group group{*this};
+	split(group, begin, end, grain ? grain : 1, body);
+	group.join();
+}
+
+} /* namespace task_control */
+
+#endif /* JOB_POOL_H_ */
@@ -25,29 +25,68 @@
  * IN THE SOFTWARE.
  */
 #include <task_control/named_task.h>
+#include <memory>
 
 using namespace task_control;
 using namespace std;
 
 named_task::named_task(const string& name, task_function_t task)
+	: named_task{name, task, nullptr}
+{
+}
+
+named_task::named_task(const string& name, task_function_t task, task_executor& executor)
+	: named_task{name, task, &executor}
+{
+}
+
+named_task::named_task(const string& name, task_function_t task, const thread_options& options)
+	: named_task{name, task, nullptr}
+{
+	thread_options_ = options;
+	own_thread_options_ = true;
+}
+
+named_task::named_task(const string& name, task_function_t task, task_executor* executor)
 	: name_{name},
-	  shutdown_{false}
+	  thread_joinable_{false},
+	  own_thread_options_{false},
+	  executor_{executor},
+	  init_reported_{false},
+	  running_{false},
+	  stopping_{false},
+	  restart_requested_{false},
+	  restart_delay_{0},
+	  restarts_{0}
 {
-	  task_function_ = [task] (init_callback_t init_callback, const bool& stop, promise<void>& result) {
-	  		try {
-	  			task(init_callback, stop);
-	  			result.set_value();
-	  		} catch (...) {
-	  			result.set_exception(current_exception());
-	  		}
+	  task_function_ = [this, task] (init_callback_t init_callback, const stop_token& stop, promise<void>& result) {
+	  		heartbeat::set_current(&heartbeat_);
+	  		exception_ptr failure;
+	  		chrono::milliseconds delay;
+	  		do {
+	  			heartbeat_.beat();
+	  			failure = nullptr;
+	  			metrics_.entered();
+	  			try {
+	  				task(init_callback, stop);
+	  			} catch (...) {
+	  				failure = current_exception();
+	  			}
+	  			metrics_.left();
+	  			if (failure)
+	  				metrics_.failed(failure);
+	  		} while (restart_after(failure, delay) && back_off(delay));
+	  		heartbeat_.beat();
+	  		heartbeat::set_current(nullptr);
+	  		metrics_.exited();
+	  		exited(result, failure);
 	  	};
 }
 
 named_task::~named_task() {
-	if (!shutdown_)
+	if (!stopping())
 		stop();
-	if(thread_.joinable())
-		thread_.join();
+	wait_finished();
 }
 
 const string& named_task::name() const {
@@ -55,28 +94,205 @@ const string& named_task::name() const {
 }
 
 future<bool> named_task::start() {
-	if (shutdown_ && thread_.joinable())
-		thread_.join();
+	return start(nullptr);
+}
 
-	shutdown_ = false;
+future<bool> named_task::start(init_listener_t on_init) {
+	if (stopping())
+		wait_finished();
+
+	stop_.reset();
+	{
+		lock_guard<mutex> lock{exit_mutex_};
+		running_ = true;
+		stopping_ = false;
+		restart_requested_ = false;
+		on_exit_ = nullptr;
+	}
 	init_result_ = promise<bool>{};
-	auto init_callback = [&](bool success) { init_result_.set_value(success); };
+	init_reported_ = false;
+	metrics_.started();
+	heartbeat_.beat();
+	// Only the first init is reported; restarts in place init silently.
+	auto init_callback = [this, on_init](bool success) {
+		heartbeat_.beat();
+		if(init_reported_.exchange(true))
+			return;
+		metrics_.initialized();
+		init_result_.set_value(success);
+		if(on_init)
+			on_init(success);
+	};
 	result_promise_ = promise<void>{};
 	result_future_ = result_promise_.get_future();
-	thread_ = thread{ref(task_function_), init_callback, ref(shutdown_), ref(result_promise_)};
+	if(executor_) {
+		auto finished = make_shared<promise<void>>();
+		finished_ = finished->get_future();
+		executor_->submit([this, init_callback, finished] {
+			task_function_(init_callback, stop_, result_promise_);
+			finished->set_value();
+		});
+	} else {
+		auto options = thread_options_;
+		auto fail = [this, init_callback](exception_ptr failure) {
+			init_callback(false);
+			metrics_.exited();
+			exited(result_promise_, failure);
+		};
+		exception_ptr spawn_failure;
+		try {
+			thread_ = options.spawn([this, init_callback, options, fail] {
+				exception_ptr failure;
+				try {
+					options.apply_here(name_);
+				} catch (...) {
+					failure = current_exception();
+				}
+				if(failure)
+					fail(failure);
+				else
+					task_function_(init_callback, stop_, result_promise_);
+			});
+			thread_joinable_ = true;
+		} catch (...) {
+			spawn_failure = current_exception();
+		}
+		// A thread that cannot be had fails the init like any other.
+		if(spawn_failure)
+			fail(spawn_failure);
+	}
 
 	return init_result_.get_future();
 }
 
 future<void> named_task::stop() {
-	shutdown_ = true;
+	return stop(nullptr);
+}
+
+future<void> named_task::stop(exit_listener_t on_exit) {
+	{
+		unique_lock<mutex> lock{exit_mutex_};
+		stopping_ = true;
+		if(on_exit) {
+			if(running_) {
+				on_exit_ = move(on_exit);
+			} else {
+				lock.unlock();
+				on_exit();
+			}
+		}
+	}
+	metrics_.stop_requested();
+	stop_.request_stop();
 	return move(result_future_);
 }
 
+void named_task::restart(const chrono::milliseconds& delay) {
+	{
+		lock_guard<mutex> lock{exit_mutex_};
+		if(!running_ || stopping_)
+			return;
+		restart_requested_ = true;
+		restart_delay_ = delay;
+	}
+	stop_.request_stop();
+}
+
+void named_task::on_failure(failure_handler_t handler) {
+	lock_guard<mutex> lock{exit_mutex_};
+	failure_handler_ = move(handler);
+}
+
+unsigned long named_task::restarts() const {
+	return restarts_.load();
+}
+
+bool named_task::stopping() {
+	lock_guard<mutex> lock{exit_mutex_};
+	return stopping_;
+}
+
+bool named_task::restart_after(exception_ptr failure, chrono::milliseconds& delay) {
+	failure_handler_t handler;
+	{
+		lock_guard<mutex> lock{exit_mutex_};
+		if(stopping_)
+			return false;
+		if(restart_requested_) {
+			delay = restart_delay_;
+			return true;
+		}
+		handler = failure_handler_;
+	}
+	return handler && handler(*this, failure, delay);
+}
+
+bool named_task::back_off(chrono::milliseconds delay) {
+	while(true) {
+		{
+			lock_guard<mutex> lock{exit_mutex_};
+			if(stopping_)
+				return false;
+			restart_requested_ = false;
+			stop_.reset();
+		}
+		if(!stop_.wait_for(delay))
+			break;
+		// Woken by restart(), which starts the wait over, or by stop().
+		lock_guard<mutex> lock{exit_mutex_};
+		delay = restart_delay_;
+	}
+	restarts_.fetch_add(1);
+	return true;
+}
+
+void named_task::exited(promise<void>& result, exception_ptr failure) {
+	exit_listener_t on_exit;
+	{
+		lock_guard<mutex> lock{exit_mutex_};
+		running_ = false;
+		on_exit = move(on_exit_);
+		on_exit_ = nullptr;
+	}
+	// Whoever waits on the result finds the task no longer running.
+	if (failure)
+		result.set_exception(failure);
+	else
+		result.set_value();
+	if(on_exit)
+		on_exit();
+}
+
+void named_task::wait_finished() {
+	if(thread_joinable_) {
+		pthread_join(thread_, nullptr);
+		thread_joinable_ = false;
+	}
+	if(finished_.valid())
+		finished_.wait();
+}
+
 bool named_task::still_running(const chrono::milliseconds& max_wait_time) const {
 	return (result_future_.wait_for(max_wait_time) == future_status::timeout);
 }
 
+bool named_task::running() const {
+	return running_.load();
+}
+
+void named_task::default_thread_options(const thread_options& options) {
+	if(!own_thread_options_)
+		thread_options_ = options;
+}
+
+const heartbeat& named_task::pulse() const {
+	return heartbeat_;
+}
+
+task_stats named_task::stats() const {
+	return metrics_.snapshot(name_, running_.load(), restarts_.load());
+}
+
 
 
 
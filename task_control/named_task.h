@@ -28,23 +28,50 @@
 #ifndef NAMED_TASK_H_
 #define NAMED_TASK_H_
 
+#include <atomic>
+#include <chrono>
+#include <exception>
 #include <functional>
 #include <future>
 #include <string>
+#include <mutex>
 #include <thread>
+#include <task_control/heartbeat.h>
+#include <task_control/stop_token.h>
+#include <task_control/task_stats.h>
+#include <task_control/thread_options.h>
+#include <task_control/task_executor.h>
 
 #include <iostream>
 
-#define TASK_FUNC_SIG void (typename task_control::named_task::init_callback_t,const bool&)
+#define TASK_FUNC_SIG void (typename task_control::named_task::init_callback_t,const task_control::stop_token&)
 
 namespace task_control {
 
+/*
+ * A named, long-running task function started and stopped on request.
+ *
+ * By default a task runs on a thread of its own. Running on a shared
+ * task_executor is opted into per task, the reverse of making the pool
+ * the default: a task holds its worker for as long as it runs, so a
+ * default pool of fixed size would leave every task beyond its size
+ * waiting to start. Tasks that come in large numbers share an executor
+ * sized for them instead.
+ */
 class named_task {
 public:
 	typedef std::function<void(bool)> init_callback_t;
-	typedef std::function<void (init_callback_t,const bool&)> task_function_t;
+	typedef std::function<void (init_callback_t,const stop_token&)> task_function_t;
+	typedef std::function<void(bool)> init_listener_t;
+	typedef std::function<void()> exit_listener_t;
+	typedef std::function<bool(const named_task&, std::exception_ptr, std::chrono::milliseconds& delay)> failure_handler_t;
 
+	// Runs on a thread of its own, spawned on every start(), set up with
+	// the options given here or else with those of its batch.
 	named_task(const std::string& name, task_function_t task);
+	named_task(const std::string& name, task_function_t task, const thread_options& options);
+	// Runs on one of the executor's workers, which must outlive the task.
+	named_task(const std::string& name, task_function_t task, task_executor& executor);
 	named_task() = delete;
 	named_task(const named_task&) = delete;
 	named_task(named_task&& original) = delete;
@@ -54,17 +81,68 @@ public:
 
 	const std::string& name() const;
 	std::future<bool> start();
+	// on_init runs on the task's thread right after the task reports its init.
+	std::future<bool> start(init_listener_t on_init);
 	std::future<void> stop();
+	// on_exit runs once the task function has returned, or right away if
+	// it is not running.
+	std::future<void> stop(exit_listener_t on_exit);
 	bool still_running(const std::chrono::milliseconds& max_wait_time) const;
+	// Whether the task function is running, without waiting.
+	bool running() const;
+	const heartbeat& pulse() const;
+	// Takes effect on the next start(), unless the task has options of its
+	// own. Tasks on an executor run on its workers as they are.
+	void default_thread_options(const thread_options& options);
+
+	/*
+	 * Restarts happen in place: the task function is called again on the
+	 * same thread or executor worker once the delay has passed, without
+	 * going through stop() and start(). A stop() ends the task instead,
+	 * during the delay too.
+	 *
+	 * The failure handler runs on the task's thread whenever the task
+	 * function throws, or returns without being stopped; the exception is
+	 * null in the latter case. It returns whether to restart, and after
+	 * which delay. Without a handler the task ends as before.
+	 */
+	void on_failure(failure_handler_t handler);
+	// Makes a running task return through its stop token and restart.
+	void restart(const std::chrono::milliseconds& delay);
+	unsigned long restarts() const;
+	task_stats stats() const;
 
 private:
+	named_task(const std::string& name, task_function_t task, task_executor* executor);
+	void wait_finished();
+	void exited(std::promise<void>& result, std::exception_ptr failure);
+	bool stopping();
+	bool restart_after(std::exception_ptr failure, std::chrono::milliseconds& delay);
+	bool back_off(std::chrono::milliseconds delay);
+
 	std::string name_;
-	std::function<void (init_callback_t,const bool&, std::promise<void>&)> task_function_;
+	std::function<void (init_callback_t,const stop_token&, std::promise<void>&)> task_function_;
 	std::promise<void> result_promise_;
 	std::future<void> result_future_;
-	std::thread thread_;
+	pthread_t thread_;
+	bool thread_joinable_;
+	thread_options thread_options_;
+	bool own_thread_options_;
+	task_executor* executor_;
+	std::future<void> finished_;
 	std::promise<bool> init_result_;
-	bool shutdown_;
+	std::atomic<bool> init_reported_;
+	stop_token stop_;
+	std::mutex exit_mutex_;
+	std::atomic<bool> running_;
+	bool stopping_;
+	bool restart_requested_;
+	std::chrono::milliseconds restart_delay_;
+	failure_handler_t failure_handler_;
+	std::atomic<unsigned long> restarts_;
+	exit_listener_t on_exit_;
+	heartbeat heartbeat_;
+	task_metrics metrics_;
 };
 
 } /* namespace task_control */
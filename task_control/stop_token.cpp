@@ -0,0 +1,111 @@
+/*
+ * stop_token.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Georgios Dimitriadis
+ *
+ * Copyright (C) 2026 Georgios Dimitriadis
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ *   The above copyright notice and this permission notice shall be
+ *   included in all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#include <task_control/stop_token.h>
+#include <cerrno>
+#include <cstdint>
+#include <system_error>
+#include <vector>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+using namespace task_control;
+using namespace std;
+
+stop_token::stop_token()
+	: stopped_{false},
+	  next_callback_id_{0},
+	  fd_{-1}
+{
+}
+
+stop_token::~stop_token() {
+	if(fd_ >= 0)
+		::close(fd_);
+}
+
+void stop_token::wait() const {
+	if(stop_requested())
+		return;
+	unique_lock<mutex> lock{mutex_};
+	stop_requested_.wait(lock, [this] { return stop_requested(); });
+}
+
+stop_token::callback_id_t stop_token::on_stop(callback_t callback) const {
+	{
+		lock_guard<mutex> lock{mutex_};
+		if(!stop_requested()) {
+			callbacks_[++next_callback_id_] = move(callback);
+			return next_callback_id_;
+		}
+	}
+	callback();
+	return 0;
+}
+
+void stop_token::remove_on_stop(callback_id_t id) const {
+	lock_guard<mutex> lock{mutex_};
+	callbacks_.erase(id);
+}
+
+int stop_token::fd() const {
+	lock_guard<mutex> lock{mutex_};
+	if(fd_ < 0) {
+		fd_ = ::eventfd(stop_requested() ? 1 : 0, EFD_CLOEXEC|EFD_NONBLOCK);
+		if(fd_ < 0)
+			throw system_error(errno, system_category(), "stop_token: cannot create eventfd");
+	}
+	return fd_;
+}
+
+void stop_token::request_stop() {
+	vector<callback_t> callbacks;
+	{
+		lock_guard<mutex> lock{mutex_};
+		if(stopped_.exchange(true, memory_order_acq_rel))
+			return;
+		if(fd_ >= 0) {
+			uint64_t one = 1;
+			if(::write(fd_, &one, sizeof(one)) < 0) { }
+		}
+		for(auto& callback : callbacks_)
+			callbacks.push_back(move(callback.second));
+		callbacks_.clear();
+	}
+	stop_requested_.notify_all();
+	for(auto& callback : callbacks)
+		callback();
+}
+
+void stop_token::reset() {
+	lock_guard<mutex> lock{mutex_};
+	stopped_.store(false, memory_order_release);
+	callbacks_.clear();
+	if(fd_ >= 0) {
+		uint64_t count;
+		if(::read(fd_, &count, sizeof(count)) < 0) { }
+	}
+}
@@ -0,0 +1,105 @@
+/*
+ * stop_token.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Georgios Dimitriadis
+ *
+ * Copyright (C) 2026 Georgios Dimitriadis
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ *   The above copyright notice and this permission notice shall be
+ *   included in all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#ifndef STOP_TOKEN_H_
+#define STOP_TOKEN_H_
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <map>
+#include <mutex>
+
+namespace task_control {
+
+/*
+ * The stop signal a named_task hands to its task function. Tasks can poll
+ * it, block on it until a deadline, register callbacks that run when stop
+ * is requested (to close a socket or wake some other wait), or add fd() to
+ * a poll/epoll set. A task only ever sees it as const; the owner requests
+ * the stop and resets the token before a restart.
+ */
+class stop_token {
+public:
+	typedef std::function<void()> callback_t;
+	typedef std::size_t callback_id_t;
+
+	stop_token();
+	stop_token(const stop_token&) = delete;
+	stop_token& operator = (const stop_token&) = delete;
+	~stop_token();
+
+	bool stop_requested() const { return stopped_.load(std::memory_order_acquire); }
+	explicit operator bool() const { return stop_requested(); }
+
+	// Return true if stop was requested, false on timeout.
+	template<typename Rep, typename Period>
+	bool wait_for(const std::chrono::duration<Rep, Period>& timeout) const;
+	template<typename Clock, typename Duration>
+	bool wait_until(const std::chrono::time_point<Clock, Duration>& deadline) const;
+	void wait() const;
+
+	// Runs callback on the thread requesting the stop, or right away if
+	// stop was already requested. A callback that is running when it is
+	// removed still completes.
+	callback_id_t on_stop(callback_t callback) const;
+	void remove_on_stop(callback_id_t id) const;
+
+	// An eventfd that becomes readable when stop is requested, created on
+	// first use and owned by the token.
+	int fd() const;
+
+	void request_stop();
+	// Clears the stop request and drops registered callbacks.
+	void reset();
+
+private:
+	std::atomic<bool> stopped_;
+	mutable std::mutex mutex_;
+	mutable std::condition_variable stop_requested_;
+	mutable std::map<callback_id_t, callback_t> callbacks_;
+	mutable callback_id_t next_callback_id_;
+	mutable int fd_;
+};
+
+template<typename Rep, typename Period>
+bool stop_token::wait_for(const std::chrono::duration<Rep, Period>& timeout) const {
+	return wait_until(std::chrono::steady_clock::now() + timeout);
+}
+
+template<typename Clock, typename Duration>
+bool stop_token::wait_until(const std::chrono::time_point<Clock, Duration>& deadline) const {
+	if(stop_requested())
+		return true;
+	std::unique_lock<std::mutex> lock{mutex_};
+	return stop_requested_.wait_until(lock, deadline, [this] { return stop_requested(); });
+}
+
+} /* namespace task_control */
+
+#endif /* STOP_TOKEN_H_ */
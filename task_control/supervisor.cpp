@@ -0,0 +1,111 @@
+/*
+ * supervisor.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Georgios Dimitriadis
+ *
+ * Copyright (C) 2026 Georgios Dimitriadis
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ *   The above copyright notice and this permission notice shall be
+ *   included in all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#include <task_control/supervisor.h>
+#include <algorithm>
+
+using namespace task_control;
+using namespace std;
+
+namespace {
+
+void forget_before(deque<chrono::steady_clock::time_point>& times, const chrono::steady_clock::time_point& horizon) {
+	while(!times.empty() && times.front() < horizon)
+		times.pop_front();
+}
+
+}
+
+supervisor::supervisor(task_batch& batch, const policy& rules, give_up_reporter_t report)
+	: rules_(rules),
+	  report_{move(report)},
+	  restarts_{0},
+	  gave_up_{false},
+	  random_{random_device{}()}
+{
+	batch.for_each([this](named_task& task) { tasks_.push_back(&task); });
+	for(auto task : tasks_) {
+		task->on_failure([this](const named_task& failed, exception_ptr failure, chrono::milliseconds& delay) {
+			return handle(failed, failure, delay);
+		});
+	}
+}
+
+supervisor::~supervisor() {
+	for(auto task : tasks_)
+		task->on_failure(nullptr);
+}
+
+unsigned long supervisor::restarts() const {
+	lock_guard<mutex> lock{mutex_};
+	return restarts_;
+}
+
+bool supervisor::gave_up() const {
+	lock_guard<mutex> lock{mutex_};
+	return gave_up_;
+}
+
+bool supervisor::handle(const named_task& failed, exception_ptr failure, chrono::milliseconds& delay) {
+	unique_lock<mutex> lock{mutex_};
+	const auto now = clock_t::now();
+	forget_before(recent_, now - rules_.period);
+	if(gave_up_ || recent_.size() >= rules_.max_restarts) {
+		gave_up_ = true;
+		lock.unlock();
+		if(report_)
+			report_(failed, failure);
+		return false;
+	}
+
+	auto& recent_of_task = recent_by_task_[&failed];
+	forget_before(recent_of_task, now - rules_.period);
+	delay = backoff(rules_.restart == strategy::one_for_all ? recent_.size() : recent_of_task.size());
+	recent_.push_back(now);
+	recent_of_task.push_back(now);
+	++restarts_;
+	lock.unlock();
+
+	if(rules_.restart == strategy::one_for_all) {
+		const auto all_delay = delay;
+		for(auto task : tasks_) {
+			if(task != &failed)
+				task->restart(all_delay);
+		}
+	}
+	return true;
+}
+
+chrono::milliseconds supervisor::backoff(size_t recent_restarts) {
+	auto delay = rules_.initial_backoff;
+	for(size_t i=0; i<recent_restarts && delay < rules_.max_backoff; ++i)
+		delay *= 2;
+	delay = min(delay, rules_.max_backoff);
+
+	uniform_real_distribution<double> off{0.0, rules_.jitter};
+	auto jitter = static_cast<chrono::milliseconds::rep>(static_cast<double>(delay.count()) * off(random_));
+	return delay - chrono::milliseconds{jitter};
+}
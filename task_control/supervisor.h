@@ -0,0 +1,106 @@
+/*
+ * supervisor.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Georgios Dimitriadis
+ *
+ * Copyright (C) 2026 Georgios Dimitriadis
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ *   The above copyright notice and this permission notice shall be
+ *   included in all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#ifndef SUPERVISOR_H_
+#define SUPERVISOR_H_
+
+#include <task_control/task_batch.h>
+#include <chrono>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <random>
+#include <vector>
+
+namespace task_control {
+
+/*
+ * Restarts the tasks of a batch that fail, that is that throw or return
+ * without being stopped. With one_for_one only the failed task restarts,
+ * with one_for_all every running task of the batch restarts along with it.
+ * Restarts happen in place, on the thread or worker the task already
+ * runs on.
+ *
+ * The delay before a restart starts at initial_backoff and doubles with
+ * every restart of the same task (of any task with one_for_all) within
+ * the last period, up to max_backoff. Up to jitter of it, as a fraction,
+ * is taken off at random so that tasks failing together do not restart
+ * in lockstep. More than max_restarts restarts within period make the
+ * supervisor give up for good: the failed task ends with its exception,
+ * the reporter is told, and no task is restarted any more. The other
+ * tasks are left running.
+ *
+ * The supervisor hooks into the tasks the batch holds when it is
+ * constructed and keeps to those tasks, so the batch may be moved, for
+ * instance into a task_batch_stack, afterwards. It must outlive their
+ * runs: stop the tasks before destroying it.
+ */
+class supervisor {
+public:
+	enum class strategy { one_for_one, one_for_all };
+
+	struct policy {
+		strategy restart;
+		std::chrono::milliseconds initial_backoff;
+		std::chrono::milliseconds max_backoff;
+		double jitter;
+		unsigned max_restarts;
+		std::chrono::milliseconds period;
+	};
+
+	typedef std::function<void(const named_task&, std::exception_ptr)> give_up_reporter_t;
+
+	supervisor(task_batch& batch, const policy& rules, give_up_reporter_t report=nullptr);
+	supervisor(const supervisor&) = delete;
+	supervisor& operator = (const supervisor&) = delete;
+	~supervisor();
+
+	unsigned long restarts() const;
+	bool gave_up() const;
+
+private:
+	typedef std::chrono::steady_clock clock_t;
+
+	bool handle(const named_task& failed, std::exception_ptr failure, std::chrono::milliseconds& delay);
+	std::chrono::milliseconds backoff(std::size_t recent_restarts);
+
+	std::vector<named_task*> tasks_;
+	policy rules_;
+	give_up_reporter_t report_;
+	mutable std::mutex mutex_;
+	std::deque<clock_t::time_point> recent_;
+	std::map<const named_task*, std::deque<clock_t::time_point>> recent_by_task_;
+	unsigned long restarts_;
+	bool gave_up_;
+	std::minstd_rand random_;
+};
+
+} /* namespace task_control */
+
+#endif /* SUPERVISOR_H_ */
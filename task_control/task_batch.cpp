@@ -26,46 +26,136 @@
  * 
  */
 #include <task_control/task_batch.h>
+#include <task_control/completion_queue.h>
+#include <algorithm>
+#include <memory>
 
 using namespace task_control;
 using namespace std;
 
 
 void task_batch::add(task_ptr_t&& task_func) {
+	if(has_thread_options_)
+		task_func->default_thread_options(thread_options_);
 	tasks_.emplace_back(std::move(task_func));
 }
 
-void task_batch::start(const std::chrono::milliseconds& max_wait, failure_reporter_t report) {
-	std::map<named_task*, std::future<bool>> spawned_tasks;
+void task_batch::set_thread_options(const thread_options& defaults) {
+	thread_options_ = defaults;
+	has_thread_options_ = true;
 	for(auto& task : tasks_)
-		spawned_tasks[task.get()] = task->start();
+		task->default_thread_options(defaults);
+}
 
-	auto deadline = std::chrono::system_clock::now() + max_wait;
-	for(auto& spawned_task : spawned_tasks) {
-		if ((spawned_task.second.wait_until(deadline) != std::future_status::ready) || !spawned_task.second.get()) {
-			if(report)
-				report(*spawned_task.first);
-		}
+bool batch_result::succeeded() const {
+	return count(task_outcome::status::succeeded) == outcomes.size();
+}
+
+std::size_t batch_result::count(task_outcome::status result) const {
+	return static_cast<std::size_t>(std::count_if(outcomes.begin(), outcomes.end(),
+			[result](const task_outcome& outcome) { return outcome.result == result; }));
+}
+
+namespace {
+
+// Tasks a batch operation waits for, indexed like the events they push.
+struct pending_tasks {
+	std::vector<named_task*> tasks;
+	std::vector<std::chrono::steady_clock::time_point> since;
+	std::vector<bool> decided;
+
+	std::size_t add(named_task* task) {
+		tasks.push_back(task);
+		since.push_back(std::chrono::steady_clock::now());
+		decided.push_back(false);
+		return tasks.size() - 1;
+	}
+
+	task_outcome decide(std::size_t id, task_outcome::status result, const std::chrono::steady_clock::time_point& at) {
+		decided[id] = true;
+		return task_outcome{tasks[id], result, at - since[id]};
 	}
+};
+
 }
 
-void task_batch::stop(const std::chrono::milliseconds& max_wait, failure_reporter_t report) {
-	std::map<named_task*, std::future<void>> stopped_tasks;
-	for(auto& task : tasks_)
-		stopped_tasks[task.get()] = task->stop();
+batch_result task_batch::start(const std::chrono::milliseconds& max_wait, failure_reporter_t report,
+		wait_policy policy) {
+	auto inits = std::make_shared<completion_queue>();
+	pending_tasks pending;
+	for(auto& task : tasks_) {
+		auto id = pending.add(task.get());
+		task->start([inits, id](bool success) { inits->push(id, success); });
+	}
 
-	auto deadline = std::chrono::system_clock::now() + max_wait;
-	for(auto& stopped_task : stopped_tasks) {
-		if(stopped_task.second.wait_until(deadline) != std::future_status::ready) {
+	batch_result result;
+	auto deadline = std::chrono::steady_clock::now() + max_wait;
+	auto waiting = pending.tasks.size();
+	completion_queue::event event;
+	while(waiting && inits->pop(event, deadline)) {
+		--waiting;
+		result.outcomes.push_back(pending.decide(event.id,
+				event.success ? task_outcome::status::succeeded : task_outcome::status::failed, event.at));
+		if(!event.success) {
 			if(report)
-				report(*stopped_task.first);
+				report(*pending.tasks[event.id]);
+			if(policy == wait_policy::fail_fast)
+				break;
 		}
 	}
+
+	auto now = std::chrono::steady_clock::now();
+	auto left_over = waiting && now < deadline ? task_outcome::status::abandoned : task_outcome::status::timed_out;
+	for(std::size_t id=0; id<pending.tasks.size(); ++id) {
+		if(pending.decided[id])
+			continue;
+		result.outcomes.push_back(pending.decide(id, left_over, now));
+		if(report && left_over == task_outcome::status::timed_out)
+			report(*pending.tasks[id]);
+	}
+	return result;
+}
+
+batch_result task_batch::stop(const std::chrono::milliseconds& max_wait, failure_reporter_t report) {
+	auto exits = std::make_shared<completion_queue>();
+	pending_tasks pending;
+	for(auto& task : tasks_) {
+		auto id = pending.add(task.get());
+		task->stop([exits, id] { exits->push(id, true); });
+	}
+
+	batch_result result;
+	auto deadline = std::chrono::steady_clock::now() + max_wait;
+	auto waiting = pending.tasks.size();
+	completion_queue::event event;
+	while(waiting && exits->pop(event, deadline)) {
+		--waiting;
+		result.outcomes.push_back(pending.decide(event.id, task_outcome::status::succeeded, event.at));
+	}
+
+	auto now = std::chrono::steady_clock::now();
+	for(std::size_t id=0; id<pending.tasks.size(); ++id) {
+		if(pending.decided[id])
+			continue;
+		result.outcomes.push_back(pending.decide(id, task_outcome::status::timed_out, now));
+		if(report)
+			report(*pending.tasks[id]);
+	}
+	return result;
 }
 
 void task_batch::inspect(const std::chrono::milliseconds& max_wait, failure_reporter_t report) const {
+	auto deadline = std::chrono::steady_clock::now() + max_wait;
 	for(const auto& task : tasks_) {
-		if(!task->still_running(max_wait))
+		auto left = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now());
+		if(!task->still_running(std::max(left, std::chrono::milliseconds::zero())))
 			report(*task);
 	}
 }
+
+std::vector<task_stats> task_batch::stats() const {
+	std::vector<task_stats> all;
+	for(const auto& task : tasks_)
+		all.push_back(task->stats());
+	return all;
+}
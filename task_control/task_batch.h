@@ -32,28 +32,85 @@
 #include <vector>
 #include <list>
 #include <string>
-#include <map>
 
 namespace task_control {
 
+// How one task of a batch came out of a start or stop.
+struct task_outcome {
+	enum class status {
+		succeeded,
+		failed,
+		timed_out,
+		// Still pending when a fail-fast start gave up on the batch.
+		abandoned
+	};
+
+	const named_task* task;
+	status result;
+	// From the call to start() or stop() of the task until it reported,
+	// or until the batch stopped waiting for it.
+	std::chrono::steady_clock::duration latency;
+};
+
+// Outcomes in the order they were decided.
+struct batch_result {
+	std::vector<task_outcome> outcomes;
+
+	bool succeeded() const;
+	std::size_t count(task_outcome::status result) const;
+};
+
 class task_batch {
 public:
 	typedef std::unique_ptr<named_task> task_ptr_t;
 	typedef std::function<void(const named_task&)> failure_reporter_t;
 
-	task_batch() { };
-	task_batch(task_batch&& other) : tasks_{std::move(other.tasks_)} { }
+	enum class wait_policy {
+		all,
+		// Stop waiting on the first failure instead of on the deadline.
+		fail_fast
+	};
+
+	task_batch() : has_thread_options_{false} { };
+	task_batch(task_batch&& other)
+		: tasks_{std::move(other.tasks_)},
+		  thread_options_(std::move(other.thread_options_)),
+		  has_thread_options_{other.has_thread_options_} { }
 	task_batch(const task_batch&) = delete;
 	task_batch& operator = (const task_batch&) = delete;
 
 
 	void add(task_ptr_t&& task_func);
-	void start(const std::chrono::milliseconds& max_wait, failure_reporter_t report=nullptr);
-	void stop(const std::chrono::milliseconds& max_wait, failure_reporter_t report=nullptr);
+	// Thread options for the tasks added before or after that have none
+	// of their own.
+	void set_thread_options(const thread_options& defaults);
+	/*
+	 * Failures are reported as they happen: a failed init as soon as the
+	 * task reports it, timeouts once the deadline passes. Tasks abandoned
+	 * by a fail-fast start are not reported but keep starting; stop the
+	 * batch before starting it again.
+	 */
+	batch_result start(const std::chrono::milliseconds& max_wait, failure_reporter_t report=nullptr,
+			wait_policy policy=wait_policy::all);
+	batch_result stop(const std::chrono::milliseconds& max_wait, failure_reporter_t report=nullptr);
+	// Waits at most max_wait in total for the running tasks, not per task.
 	void inspect(const std::chrono::milliseconds& max_wait, failure_reporter_t report) const;
+	std::vector<task_stats> stats() const;
+	template<typename Visitor>
+	void for_each(Visitor visit) const {
+		for(const auto& task : tasks_)
+			visit(static_cast<const named_task&>(*task));
+	}
+	template<typename Visitor>
+	void for_each(Visitor visit) {
+		for(auto& task : tasks_)
+			visit(*task);
+	}
 
 private:
 	std::list<task_ptr_t> tasks_;
+	thread_options thread_options_;
+	bool has_thread_options_;
 };
 
 } /* namespace task_control */
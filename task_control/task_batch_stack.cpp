@@ -26,50 +26,133 @@
  * 
  */
 #include <task_control/task_batch_stack.h>
+#include <algorithm>
 
 using namespace task_control;
 using namespace std;
 
+task_batch_stack::task_batch_stack()
+	: default_start_timeout_{1000},
+	  default_stop_timeout_{1000},
+	  in_transit_{nullptr},
+	  target_level_{0},
+	  target_timeout_{0},
+	  requested_{0},
+	  settled_{0},
+	  done_{false}
+{
+	worker_ = thread{&task_batch_stack::transition_loop, this};
+}
+
+task_batch_stack::~task_batch_stack() {
+	{
+		lock_guard<mutex> lock{async_mutex_};
+		done_ = true;
+	}
+	async_changed_.notify_all();
+	worker_.join();
+}
+
 void task_batch_stack::push_top(task_batch&& batch) {
-	dormant_batches_.emplace_back(std::move(batch));
+	lock_guard<mutex> lock{batches_mutex_};
+	dormant_batches_.emplace_back(stacked_batch{std::move(batch), false, {}, {}});
 }
 
-int task_batch_stack::bring_up_to_level(unsigned max_level) {
-	while (running_batches_.size() < max_level ) {
-		auto batch = std::move(dormant_batches_.front());
-		dormant_batches_.pop_front();
-		std::vector<std::string> failed_inits;
-		batch.start(std::chrono::milliseconds{1000}, [&](const named_task& task){ failed_inits.push_back(task.name()); });
-		if (failed_inits.size() > 0) {
-			dormant_batches_.emplace_front(std::move(batch));
-			break;
-		} else {
-			running_batches_.emplace_front(std::move(batch));
-		}
+void task_batch_stack::push_top(task_batch&& batch, const std::chrono::milliseconds& start_timeout,
+		const std::chrono::milliseconds& stop_timeout) {
+	lock_guard<mutex> lock{batches_mutex_};
+	dormant_batches_.emplace_back(stacked_batch{std::move(batch), true, start_timeout, stop_timeout});
+}
+
+void task_batch_stack::set_default_timeouts(const std::chrono::milliseconds& start_timeout,
+		const std::chrono::milliseconds& stop_timeout) {
+	lock_guard<mutex> lock{batches_mutex_};
+	default_start_timeout_ = start_timeout;
+	default_stop_timeout_ = stop_timeout;
+}
+
+bool task_batch_stack::step_up(const std::chrono::milliseconds& batch_timeout) {
+	unique_lock<mutex> lock{batches_mutex_};
+	if (dormant_batches_.empty())
+		return false;
+	auto stacked = std::move(dormant_batches_.front());
+	dormant_batches_.pop_front();
+	auto timeout = batch_timeout.count() ? batch_timeout
+			: stacked.own_timeouts ? stacked.start_timeout : default_start_timeout_;
+	auto stop_timeout = stacked.own_timeouts ? stacked.stop_timeout : default_stop_timeout_;
+	in_transit_ = &stacked.batch;
+	lock.unlock();
+
+	bool started;
+	try {
+		started = stacked.batch.start(timeout, nullptr, task_batch::wait_policy::fail_fast).succeeded();
+		// The tasks that did init must not be left running in a dormant batch.
+		if (!started)
+			stacked.batch.stop(stop_timeout);
+	} catch (...) {
+		lock.lock();
+		in_transit_ = nullptr;
+		dormant_batches_.emplace_front(std::move(stacked));
+		throw;
 	}
 
-	return running_batches_.size();
+	lock.lock();
+	in_transit_ = nullptr;
+	if (!started) {
+		dormant_batches_.emplace_front(std::move(stacked));
+		return false;
+	}
+	running_batches_.emplace_front(std::move(stacked));
+	return true;
 }
 
-int task_batch_stack::bring_down_to_level(unsigned min_level) {
-	while (running_batches_.size() > min_level ) {
-		auto batch = std::move(running_batches_.front());
-		running_batches_.pop_front();
-		std::vector<std::string> failed_stops;
-		batch.stop(std::chrono::milliseconds{1000}, [&](const named_task& task){ failed_stops.push_back(task.name()); });
-		if (failed_stops.size() > 0) {
-			running_batches_.emplace_front(std::move(batch));
-			break;
-		} else {
-			dormant_batches_.emplace_back(std::move(batch));
-		}
+bool task_batch_stack::step_down(const std::chrono::milliseconds& batch_timeout) {
+	unique_lock<mutex> lock{batches_mutex_};
+	if (running_batches_.empty())
+		return false;
+	auto stacked = std::move(running_batches_.front());
+	running_batches_.pop_front();
+	auto timeout = batch_timeout.count() ? batch_timeout
+			: stacked.own_timeouts ? stacked.stop_timeout : default_stop_timeout_;
+	in_transit_ = &stacked.batch;
+	lock.unlock();
+
+	bool stopped;
+	try {
+		stopped = stacked.batch.stop(timeout).succeeded();
+	} catch (...) {
+		lock.lock();
+		in_transit_ = nullptr;
+		running_batches_.emplace_front(std::move(stacked));
+		throw;
 	}
 
-	return running_batches_.size();
+	lock.lock();
+	in_transit_ = nullptr;
+	if (!stopped) {
+		running_batches_.emplace_front(std::move(stacked));
+		return false;
+	}
+	dormant_batches_.emplace_front(std::move(stacked));
+	return true;
+}
+
+int task_batch_stack::bring_up_to_level(unsigned max_level) {
+	lock_guard<mutex> lock{transition_mutex_};
+	while (static_cast<unsigned>(level()) < max_level && step_up(std::chrono::milliseconds::zero()))
+		;
+	return level();
+}
+
+int task_batch_stack::bring_down_to_level(unsigned min_level) {
+	lock_guard<mutex> lock{transition_mutex_};
+	while (static_cast<unsigned>(level()) > min_level && step_down(std::chrono::milliseconds::zero()))
+		;
+	return level();
 }
 
 int task_batch_stack::set_level(unsigned level) {
-	auto current_level = running_batches_.size();
+	auto current_level = static_cast<unsigned>(this->level());
 	if (current_level < level) {
 		return bring_up_to_level(level);
 	} else if (current_level > level) {
@@ -78,14 +161,130 @@ int task_batch_stack::set_level(unsigned level) {
 	return level;
 }
 
+future<int> task_batch_stack::set_level_async(unsigned level, const std::chrono::milliseconds& batch_timeout,
+		level_callback_t on_done) {
+	future<int> result;
+	{
+		lock_guard<mutex> lock{async_mutex_};
+		waiters_.push_back(waiter{++requested_, promise<int>{}, on_done});
+		result = waiters_.back().level.get_future();
+		target_level_ = level;
+		target_timeout_ = batch_timeout;
+	}
+	async_changed_.notify_all();
+	return result;
+}
+
+int task_batch_stack::level() const {
+	lock_guard<mutex> lock{batches_mutex_};
+	return static_cast<int>(running_batches_.size());
+}
+
+void task_batch_stack::complete(unsigned long up_to_request, unique_lock<mutex>& lock) {
+	int reached = level();
+	std::vector<waiter> completed;
+	for (auto it = waiters_.begin(); it != waiters_.end(); ) {
+		if (it->request <= up_to_request) {
+			completed.push_back(std::move(*it));
+			it = waiters_.erase(it);
+		} else {
+			++it;
+		}
+	}
+	settled_ = std::max(settled_, up_to_request);
+
+	lock.unlock();
+	for (auto& done : completed) {
+		done.level.set_value(reached);
+		if (done.on_done)
+			done.on_done(reached);
+	}
+	lock.lock();
+}
+
+void task_batch_stack::transition_loop() {
+	unique_lock<mutex> lock{async_mutex_};
+	unsigned long working_on = 0;
+	while (true) {
+		async_changed_.wait(lock, [this] { return done_ || requested_ > settled_; });
+		if (done_) {
+			complete(requested_, lock);
+			return;
+		}
+
+		// A newer request preempts the one in progress between two batches.
+		if (working_on && working_on < requested_)
+			complete(working_on, lock);
+		working_on = requested_;
+		const unsigned target = target_level_;
+		const auto timeout = target_timeout_;
+		lock.unlock();
+
+		bool moved;
+		try {
+			lock_guard<mutex> transition{transition_mutex_};
+			auto current = static_cast<unsigned>(level());
+			moved = current < target ? step_up(timeout)
+					: current > target ? step_down(timeout)
+					: false;
+		} catch (...) {
+			// Nobody to hand it to; the waiters get the level reached.
+			moved = false;
+		}
+
+		lock.lock();
+		if (!moved && working_on == requested_) {
+			complete(working_on, lock);
+			working_on = 0;
+		}
+	}
+}
+
 int task_batch_stack::inspect(const std::chrono::milliseconds& max_wait) {
+	// Tasks are heap-allocated and live as long as the stack, so waiting on
+	// them needs no lock while levels change.
+	std::vector<std::vector<const named_task*>> levels;
+	{
+		lock_guard<mutex> lock{batches_mutex_};
+		for (const auto& stacked : running_batches_) {
+			levels.emplace_back();
+			stacked.batch.for_each([&](const named_task& task) { levels.back().push_back(&task); });
+		}
+	}
+
 	int passed_level{0};
-	for (auto& batch : running_batches_) {
-		bool running{true};
-		batch.inspect(max_wait, [&](const named_task&){ running = false; });
-		if (!running)
-			return passed_level;
+	for (const auto& tasks : levels) {
+		auto deadline = std::chrono::steady_clock::now() + max_wait;
+		for (auto task : tasks) {
+			auto left = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now());
+			if (!task->still_running(std::max(left, std::chrono::milliseconds::zero())))
+				return passed_level;
+		}
 		++passed_level;
 	}
 	return passed_level;
 }
+
+int task_batch_stack::check(const watchdog& dog, watchdog::reporter_t report) const {
+	lock_guard<mutex> lock{batches_mutex_};
+	int healthy_level{0};
+	bool healthy_below{true};
+	for (auto stacked = running_batches_.rbegin(); stacked != running_batches_.rend(); ++stacked) {
+		healthy_below = dog.check(stacked->batch, report) == 0 && healthy_below;
+		if (healthy_below)
+			++healthy_level;
+	}
+	return healthy_level;
+}
+
+std::vector<std::vector<task_stats>> task_batch_stack::stats() const {
+	lock_guard<mutex> lock{batches_mutex_};
+	std::vector<std::vector<task_stats>> levels;
+	for (auto stacked = running_batches_.rbegin(); stacked != running_batches_.rend(); ++stacked)
+		levels.push_back(stacked->batch.stats());
+	if (in_transit_)
+		levels.push_back(in_transit_->stats());
+	for (const auto& stacked : dormant_batches_)
+		levels.push_back(stacked.batch.stats());
+	return levels;
+}
@@ -28,22 +28,100 @@
 #ifndef TASK_BATCH_STACK_H_
 #define TASK_BATCH_STACK_H_
 #include "task_control/task_batch.h"
+#include "task_control/watchdog.h"
+#include <condition_variable>
+#include <future>
+#include <mutex>
 #include <queue>
+#include <thread>
+#include <vector>
 
 namespace task_control {
 
+/*
+ * Batches started bottom up and stopped top down. A batch whose start
+ * fails stops the climb, as does a batch whose stop fails the descent.
+ *
+ * Each batch starts and stops within its own timeouts if it was pushed
+ * with them, and within the stack's defaults (1000 ms) otherwise.
+ *
+ * set_level_async() moves the stack on a worker thread of its own. A newer
+ * target preempts the transition in progress as soon as the batch being
+ * started or stopped is done: the superseded calls complete with the level
+ * reached at that point, and the newest call once its target is reached or
+ * a batch fails. The blocking calls may be mixed with it; each batch
+ * transition is done by one of them at a time.
+ */
 class task_batch_stack {
 public:
+	typedef std::function<void(int level)> level_callback_t;
+
+	task_batch_stack();
+	task_batch_stack(const task_batch_stack&) = delete;
+	task_batch_stack& operator = (const task_batch_stack&) = delete;
+	~task_batch_stack();
 
 	void push_top(task_batch&& batch);
+	void push_top(task_batch&& batch, const std::chrono::milliseconds& start_timeout,
+			const std::chrono::milliseconds& stop_timeout);
+	void set_default_timeouts(const std::chrono::milliseconds& start_timeout,
+			const std::chrono::milliseconds& stop_timeout);
+
 	int bring_up_to_level(unsigned max_level);
 	int bring_down_to_level(unsigned min_level);
 	int set_level(unsigned level);
+	// A non-zero batch_timeout replaces the start and stop timeouts of
+	// every batch for this call. on_done runs on the worker thread.
+	std::future<int> set_level_async(unsigned level,
+			const std::chrono::milliseconds& batch_timeout=std::chrono::milliseconds::zero(),
+			level_callback_t on_done=nullptr);
+	int level() const;
 	int inspect(const std::chrono::milliseconds& max_wait);
+	// Reports every unhealthy task of the running batches in one pass and
+	// returns the number of batches, from the bottom, with only healthy tasks.
+	int check(const watchdog& dog, watchdog::reporter_t report) const;
+	// The stats of every batch, bottom up, including the one being started
+	// or stopped and the dormant ones above.
+	std::vector<std::vector<task_stats>> stats() const;
 
 private:
-	std::deque<task_batch> dormant_batches_;
-	std::deque<task_batch> running_batches_;
+	struct stacked_batch {
+		task_batch batch;
+		bool own_timeouts;
+		std::chrono::milliseconds start_timeout;
+		std::chrono::milliseconds stop_timeout;
+	};
+
+	struct waiter {
+		unsigned long request;
+		std::promise<int> level;
+		level_callback_t on_done;
+	};
+
+	bool step_up(const std::chrono::milliseconds& batch_timeout);
+	bool step_down(const std::chrono::milliseconds& batch_timeout);
+	void transition_loop();
+	void complete(unsigned long up_to_request, std::unique_lock<std::mutex>& lock);
+
+	std::deque<stacked_batch> dormant_batches_;
+	std::deque<stacked_batch> running_batches_;
+	mutable std::mutex batches_mutex_;
+	std::chrono::milliseconds default_start_timeout_;
+	std::chrono::milliseconds default_stop_timeout_;
+	// The batch a transition is starting or stopping, out of both lists.
+	const task_batch* in_transit_;
+	// Held for a whole blocking call, or for one step of the worker.
+	std::mutex transition_mutex_;
+
+	std::mutex async_mutex_;
+	std::condition_variable async_changed_;
+	unsigned target_level_;
+	std::chrono::milliseconds target_timeout_;
+	unsigned long requested_;
+	unsigned long settled_;
+	std::vector<waiter> waiters_;
+	bool done_;
+	std::thread worker_;
 };
 
 } /* namespace task_control */
@@ -0,0 +1,108 @@
+/*
+ * task_executor.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Georgios Dimitriadis
+ *
+ * Copyright (C) 2026 Georgios Dimitriadis
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ *   The above copyright notice and this permission notice shall be
+ *   included in all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#include <task_control/task_executor.h>
+#include <system_error>
+
+using namespace task_control;
+using namespace std;
+
+task_executor::task_executor(size_t threads, size_t stack_size)
+	: idle_{0},
+	  done_{false}
+{
+	pthread_attr_t attr;
+	pthread_attr_init(&attr);
+	if(stack_size)
+		pthread_attr_setstacksize(&attr, stack_size);
+
+	threads_.reserve(threads);
+	for(size_t i=0; i<threads; ++i) {
+		pthread_t thread;
+		int error = pthread_create(&thread, &attr, &task_executor::run_worker, this);
+		if(error) {
+			pthread_attr_destroy(&attr);
+			shutdown();
+			throw system_error(error, system_category(), "task_executor: cannot create worker thread");
+		}
+		threads_.push_back(thread);
+	}
+	pthread_attr_destroy(&attr);
+}
+
+task_executor::~task_executor() {
+	shutdown();
+}
+
+void task_executor::shutdown() {
+	{
+		lock_guard<mutex> lock{mutex_};
+		done_ = true;
+	}
+	job_available_.notify_all();
+	for(auto thread : threads_)
+		pthread_join(thread, nullptr);
+	threads_.clear();
+}
+
+void task_executor::submit(job_t job) {
+	{
+		lock_guard<mutex> lock{mutex_};
+		jobs_.push_back(move(job));
+	}
+	job_available_.notify_one();
+}
+
+size_t task_executor::size() const {
+	return threads_.size();
+}
+
+size_t task_executor::idle() const {
+	lock_guard<mutex> lock{mutex_};
+	return idle_;
+}
+
+void* task_executor::run_worker(void* self) {
+	static_cast<task_executor*>(self)->work();
+	return nullptr;
+}
+
+void task_executor::work() {
+	unique_lock<mutex> lock{mutex_};
+	while(true) {
+		++idle_;
+		job_available_.wait(lock, [this] { return done_ || !jobs_.empty(); });
+		--idle_;
+		if(jobs_.empty())
+			return;
+
+		job_t job = move(jobs_.front());
+		jobs_.pop_front();
+		lock.unlock();
+		job();
+		lock.lock();
+	}
+}
@@ -0,0 +1,84 @@
+/*
+ * task_executor.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Georgios Dimitriadis
+ *
+ * Copyright (C) 2026 Georgios Dimitriadis
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ *   The above copyright notice and this permission notice shall be
+ *   included in all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#ifndef TASK_EXECUTOR_H_
+#define TASK_EXECUTOR_H_
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <vector>
+#include <pthread.h>
+
+namespace task_control {
+
+/*
+ * A fixed set of worker threads that named_tasks can run on instead of
+ * spawning a thread of their own on every start(). The workers are created
+ * once, with the given stack size if it is not zero, and a task that
+ * stops hands its worker back to the next task that starts.
+ *
+ * A named_task occupies a worker for as long as it runs, so the executor
+ * must have at least as many threads as tasks running at the same time;
+ * tasks beyond that wait in line and their start() is not ready until a
+ * worker frees up.
+ *
+ * The destructor lets queued jobs run and waits for all of them, so every
+ * task on the executor must be stopped before it goes away.
+ */
+class task_executor {
+public:
+	typedef std::function<void()> job_t;
+
+	explicit task_executor(std::size_t threads, std::size_t stack_size=0);
+	task_executor(const task_executor&) = delete;
+	task_executor& operator = (const task_executor&) = delete;
+	~task_executor();
+
+	void submit(job_t job);
+
+	std::size_t size() const;
+	std::size_t idle() const;
+
+private:
+	static void* run_worker(void* self);
+	void shutdown();
+	void work();
+
+	mutable std::mutex mutex_;
+	std::condition_variable job_available_;
+	std::deque<job_t> jobs_;
+	std::vector<pthread_t> threads_;
+	std::size_t idle_;
+	bool done_;
+};
+
+} /* namespace task_control */
+
+#endif /* TASK_EXECUTOR_H_ */
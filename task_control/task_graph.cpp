@@ -0,0 +1,195 @@
+/*
+ * task_graph.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Georgios Dimitriadis
+ *
+ * Copyright (C) 2026 Georgios Dimitriadis
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ *   The above copyright notice and this permission notice shall be
+ *   included in all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#include <task_control/task_graph.h>
+#include <task_control/completion_queue.h>
+#include <cstdint>
+#include <stdexcept>
+
+using namespace task_control;
+using namespace std;
+
+task_graph::task_graph() {
+}
+
+void task_graph::add(task_ptr_t&& task, const vector<string>& dependencies) {
+	if(index_.count(task->name()))
+		throw invalid_argument("task_graph: duplicate task " + task->name());
+
+	node added{move(task), {}, {}, state::stopped};
+	const size_t id = nodes_.size();
+	for(const auto& dependency : dependencies) {
+		auto found = index_.find(dependency);
+		if(found == index_.end())
+			throw invalid_argument("task_graph: " + added.task->name() + " depends on unknown task " + dependency);
+		added.dependencies.push_back(found->second);
+	}
+	for(auto dependency : added.dependencies)
+		nodes_[dependency].dependents.push_back(id);
+
+	index_[added.task->name()] = id;
+	nodes_.push_back(move(added));
+}
+
+void task_graph::add_layer(vector<task_ptr_t>&& tasks) {
+	vector<string> dependencies;
+	for(auto id : last_layer_)
+		dependencies.push_back(nodes_[id].task->name());
+
+	last_layer_.clear();
+	for(auto& task : tasks) {
+		add(move(task), dependencies);
+		last_layer_.push_back(nodes_.size() - 1);
+	}
+}
+
+bool task_graph::start(const chrono::milliseconds& max_wait, failure_reporter_t report) {
+	const auto deadline = chrono::steady_clock::now() + max_wait;
+	auto inits = make_shared<completion_queue>();
+	vector<size_t> waiting_for(nodes_.size(), 0);
+	size_t starting = 0;
+	bool all_running = true;
+
+	auto launch = [&](size_t id) {
+		nodes_[id].current = state::starting;
+		++starting;
+		nodes_[id].task->start([inits, id](bool success) { inits->push(id, success); });
+	};
+	auto give_up = [&](size_t id) {
+		all_running = false;
+		if(report)
+			report(*nodes_[id].task);
+	};
+	// Reports the not yet started tasks below a failed one, each once.
+	function<void(size_t)> abandon_dependents = [&](size_t id) {
+		for(auto dependent : nodes_[id].dependents) {
+			if(nodes_[dependent].current == state::stopped && waiting_for[dependent] != SIZE_MAX) {
+				waiting_for[dependent] = SIZE_MAX;
+				give_up(dependent);
+				abandon_dependents(dependent);
+			}
+		}
+	};
+
+	for(size_t id=0; id<nodes_.size(); ++id) {
+		for(auto dependency : nodes_[id].dependencies) {
+			if(nodes_[dependency].current != state::running)
+				++waiting_for[id];
+		}
+	}
+	for(size_t id=0; id<nodes_.size(); ++id) {
+		if(nodes_[id].current == state::failed) {
+			// Still running from a failed start, or exited; stop() cleans it up first.
+			give_up(id);
+			waiting_for[id] = SIZE_MAX;
+			abandon_dependents(id);
+		}
+	}
+	for(size_t id=0; id<nodes_.size(); ++id) {
+		if(nodes_[id].current == state::stopped && waiting_for[id] == 0)
+			launch(id);
+	}
+
+	completion_queue::event event;
+	while(starting && inits->pop(event, deadline)) {
+		const size_t id = event.id;
+		--starting;
+		if(!event.success) {
+			nodes_[id].current = state::failed;
+			give_up(id);
+			abandon_dependents(id);
+			continue;
+		}
+		nodes_[id].current = state::running;
+		for(auto dependent : nodes_[id].dependents) {
+			if(waiting_for[dependent] != SIZE_MAX && --waiting_for[dependent] == 0)
+				launch(dependent);
+		}
+	}
+
+	for(size_t id=0; id<nodes_.size(); ++id) {
+		if(nodes_[id].current == state::starting) {
+			nodes_[id].current = state::failed;
+			give_up(id);
+			abandon_dependents(id);
+		}
+	}
+	return all_running;
+}
+
+bool task_graph::stop(const chrono::milliseconds& max_wait, failure_reporter_t report) {
+	const auto deadline = chrono::steady_clock::now() + max_wait;
+	auto exits = make_shared<completion_queue>();
+	vector<size_t> running_dependents(nodes_.size(), 0);
+	size_t stopping = 0;
+
+	auto started = [&](size_t id) { return nodes_[id].current != state::stopped; };
+	auto halt = [&](size_t id) {
+		++stopping;
+		nodes_[id].task->stop([exits, id] { exits->push(id, true); });
+	};
+
+	for(size_t id=0; id<nodes_.size(); ++id) {
+		for(auto dependent : nodes_[id].dependents) {
+			if(started(dependent))
+				++running_dependents[id];
+		}
+	}
+	for(size_t id=0; id<nodes_.size(); ++id) {
+		if(started(id) && running_dependents[id] == 0)
+			halt(id);
+	}
+
+	completion_queue::event event;
+	while(stopping && exits->pop(event, deadline)) {
+		const size_t id = event.id;
+		--stopping;
+		nodes_[id].current = state::stopped;
+		for(auto dependency : nodes_[id].dependencies) {
+			if(started(dependency) && --running_dependents[dependency] == 0)
+				halt(dependency);
+		}
+	}
+
+	bool all_stopped = true;
+	for(size_t id=0; id<nodes_.size(); ++id) {
+		if(started(id)) {
+			all_stopped = false;
+			if(report && running_dependents[id] == 0)
+				report(*nodes_[id].task);
+		}
+	}
+	return all_stopped;
+}
+
+bool task_graph::running(const string& name) const {
+	auto found = index_.find(name);
+	return found != index_.end() && nodes_[found->second].current == state::running;
+}
+
+size_t task_graph::size() const {
+	return nodes_.size();
+}
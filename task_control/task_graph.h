@@ -0,0 +1,101 @@
+/*
+ * task_graph.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Georgios Dimitriadis
+ *
+ * Copyright (C) 2026 Georgios Dimitriadis
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ *   The above copyright notice and this permission notice shall be
+ *   included in all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#ifndef TASK_GRAPH_H_
+#define TASK_GRAPH_H_
+
+#include <task_control/named_task.h>
+#include <chrono>
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace task_control {
+
+/*
+ * Named tasks with dependencies on each other, started with as much
+ * parallelism as the dependencies allow: a task starts as soon as every
+ * task it depends on has reported a successful init. Stopping runs the
+ * other way round, each task being stopped once every running task that
+ * depends on it has exited.
+ *
+ * Dependencies must be added before the tasks that name them, which keeps
+ * the graph free of cycles. add_layer() makes every task of a layer depend
+ * on every task of the layer before, which gives the strictly layered
+ * order of task_batch_stack.
+ */
+class task_graph {
+public:
+	typedef std::unique_ptr<named_task> task_ptr_t;
+	typedef std::function<void(const named_task&)> failure_reporter_t;
+
+	task_graph();
+	task_graph(const task_graph&) = delete;
+	task_graph& operator = (const task_graph&) = delete;
+
+	// Throws std::invalid_argument for a duplicate name or an unknown dependency.
+	void add(task_ptr_t&& task, const std::vector<std::string>& dependencies=std::vector<std::string>());
+	void add_layer(std::vector<task_ptr_t>&& tasks);
+
+	/*
+	 * Starts every task that is not running. Tasks that fail their init or
+	 * miss the deadline are reported, and so are the tasks left unstarted
+	 * because something they depend on did not come up. Returns whether
+	 * all tasks are running. Tasks that failed must be stopped before
+	 * they can be started again.
+	 */
+	bool start(const std::chrono::milliseconds& max_wait, failure_reporter_t report=nullptr);
+	/*
+	 * Stops every started task. Tasks that do not exit before the deadline
+	 * are reported and stay running, as do the tasks they depend on.
+	 * Returns whether all tasks were stopped.
+	 */
+	bool stop(const std::chrono::milliseconds& max_wait, failure_reporter_t report=nullptr);
+
+	bool running(const std::string& name) const;
+	std::size_t size() const;
+
+private:
+	enum class state { stopped, starting, running, failed };
+
+	struct node {
+		task_ptr_t task;
+		std::vector<std::size_t> dependencies;
+		std::vector<std::size_t> dependents;
+		state current;
+	};
+
+	std::vector<node> nodes_;
+	std::map<std::string, std::size_t> index_;
+	std::vector<std::size_t> last_layer_;
+};
+
+} /* namespace task_control */
+
+#endif /* TASK_GRAPH_H_ */
@@ -0,0 +1,132 @@
+/*
+ * task_stats.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Georgios Dimitriadis
+ *
+ * Copyright (C) 2026 Georgios Dimitriadis
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ *   The above copyright notice and this permission notice shall be
+ *   included in all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#include <task_control/task_stats.h>
+#include <pthread.h>
+
+using namespace task_control;
+using namespace std;
+
+task_metrics::task_metrics()
+	: started_at_{0},
+	  init_latency_{0},
+	  stop_requested_at_{0},
+	  stop_latency_{0},
+	  exited_at_{0},
+	  cpu_clock_{CLOCK_THREAD_CPUTIME_ID},
+	  on_cpu_clock_{false},
+	  cpu_base_{0},
+	  cpu_spent_{0},
+	  starts_{0},
+	  failures_{0}
+{
+}
+
+int64_t task_metrics::now() {
+	return chrono::duration_cast<chrono::nanoseconds>(clock_t::now().time_since_epoch()).count();
+}
+
+int64_t task_metrics::cpu_now(clockid_t clock) {
+	timespec spent;
+	if(clock_gettime(clock, &spent) != 0)
+		return -1;
+	return static_cast<int64_t>(spent.tv_sec) * 1000000000 + spent.tv_nsec;
+}
+
+void task_metrics::started() {
+	started_at_ = now();
+	init_latency_ = 0;
+	stop_requested_at_ = 0;
+	exited_at_ = 0;
+	cpu_spent_ = 0;
+	++starts_;
+}
+
+void task_metrics::initialized() {
+	if(!init_latency_)
+		init_latency_ = now() - started_at_;
+}
+
+void task_metrics::stop_requested() {
+	stop_requested_at_ = now();
+}
+
+void task_metrics::entered() {
+	clockid_t clock;
+	if(pthread_getcpuclockid(pthread_self(), &clock) != 0)
+		return;
+	cpu_base_ = cpu_now(clock);
+	cpu_clock_ = clock;
+	on_cpu_clock_ = true;
+}
+
+void task_metrics::left() {
+	if(!on_cpu_clock_)
+		return;
+	on_cpu_clock_ = false;
+	cpu_spent_ += cpu_now(CLOCK_THREAD_CPUTIME_ID) - cpu_base_;
+}
+
+void task_metrics::failed(exception_ptr failure) {
+	++failures_;
+	atomic_store(&last_exception_, shared_ptr<const exception_ptr>{make_shared<exception_ptr>(failure)});
+}
+
+void task_metrics::exited() {
+	const auto at = now();
+	exited_at_ = at;
+	if(stop_requested_at_)
+		stop_latency_ = at - stop_requested_at_;
+}
+
+task_stats task_metrics::snapshot(const string& name, bool running, uint64_t restarts) const {
+	task_stats stats;
+	stats.name = name;
+	stats.running = running;
+	stats.init_latency = chrono::nanoseconds{init_latency_.load()};
+	stats.stop_latency = chrono::nanoseconds{stop_latency_.load()};
+
+	const auto started_at = started_at_.load();
+	const auto exited_at = exited_at_.load();
+	stats.run_time = chrono::nanoseconds{started_at ? (exited_at ? exited_at : now()) - started_at : 0};
+
+	int64_t cpu = cpu_spent_.load();
+	if(on_cpu_clock_) {
+		// The thread may leave the task meanwhile; its clock then reads wrong or fails.
+		const auto live = cpu_now(cpu_clock_.load()) - cpu_base_.load();
+		if(live > 0)
+			cpu += live;
+	}
+	stats.cpu_time = chrono::nanoseconds{cpu};
+
+	stats.starts = starts_.load();
+	stats.restarts = restarts;
+	stats.failures = failures_.load();
+	auto last_exception = atomic_load(&last_exception_);
+	if(last_exception)
+		stats.last_exception = *last_exception;
+	return stats;
+}
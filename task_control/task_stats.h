@@ -0,0 +1,106 @@
+/*
+ * task_stats.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Georgios Dimitriadis
+ *
+ * Copyright (C) 2026 Georgios Dimitriadis
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ *   The above copyright notice and this permission notice shall be
+ *   included in all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#ifndef TASK_STATS_H_
+#define TASK_STATS_H_
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <string>
+#include <time.h>
+
+namespace task_control {
+
+/*
+ * What a named_task has cost so far. Latencies are those of the last
+ * start and stop, zero until there is one; run and CPU time are those of
+ * the current run, or of the last one once the task has exited. The CPU
+ * time is that of the thread running the task, read through its CPU clock
+ * while the task runs.
+ */
+struct task_stats {
+	std::string name;
+	bool running;
+	std::chrono::nanoseconds init_latency;
+	std::chrono::nanoseconds stop_latency;
+	std::chrono::nanoseconds run_time;
+	std::chrono::nanoseconds cpu_time;
+	std::uint64_t starts;
+	std::uint64_t restarts;
+	std::uint64_t failures;
+	// The last exception thrown by the task function, if any.
+	std::exception_ptr last_exception;
+};
+
+/*
+ * The recording side of task_stats, kept by each named_task. Every field
+ * is an atomic written by the task or its owner, so taking a snapshot
+ * never waits for either.
+ */
+class task_metrics {
+public:
+	task_metrics();
+	task_metrics(const task_metrics&) = delete;
+	task_metrics& operator = (const task_metrics&) = delete;
+
+	void started();
+	void initialized();
+	void stop_requested();
+	// Called on the task's thread around each call of the task function.
+	void entered();
+	void left();
+	void failed(std::exception_ptr failure);
+	void exited();
+
+	task_stats snapshot(const std::string& name, bool running, std::uint64_t restarts) const;
+
+private:
+	typedef std::chrono::steady_clock clock_t;
+
+	static std::int64_t now();
+	static std::int64_t cpu_now(clockid_t clock);
+
+	std::atomic<std::int64_t> started_at_;
+	std::atomic<std::int64_t> init_latency_;
+	std::atomic<std::int64_t> stop_requested_at_;
+	std::atomic<std::int64_t> stop_latency_;
+	std::atomic<std::int64_t> exited_at_;
+	std::atomic<clockid_t> cpu_clock_;
+	std::atomic<bool> on_cpu_clock_;
+	std::atomic<std::int64_t> cpu_base_;
+	std::atomic<std::int64_t> cpu_spent_;
+	std::atomic<std::uint64_t> starts_;
+	std::atomic<std::uint64_t> failures_;
+	std::shared_ptr<const std::exception_ptr> last_exception_;
+};
+
+} /* namespace task_control */
+
+#endif /* TASK_STATS_H_ */
@@ -0,0 +1,65 @@
+/*
+ * test_heartbeat.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Georgios Dimitriadis
+ *
+ * Copyright (C) 2026 Georgios Dimitriadis
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ *   The above copyright notice and this permission notice shall be
+ *   included in all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#include "task_control/heartbeat.h"
+#include "task_control/named_task.h"
+#include "task_control/tests/testing_task_function.h"
+#include <gtest/gtest.h>
+#include <atomic>
+
+using namespace std;
+using namespace task_control;
+
+TEST(test_heartbeat, beat_and_advance) {
+	heartbeat pulse;
+	ASSERT_EQ(0, pulse.progress());
+
+	auto before = heartbeat::clock_t::now();
+	pulse.advance(3);
+	pulse.advance();
+	ASSERT_EQ(4, pulse.progress());
+	ASSERT_LE(before, pulse.last());
+	ASSERT_GE(heartbeat::clock_t::now(), pulse.last());
+}
+
+TEST(test_heartbeat, current_is_the_running_task) {
+	testing_task_function task_function;
+	task_function.run_for = chrono::milliseconds{100000};
+	atomic<int> laps{0};
+	task_function.lap_callback = [&](int) {
+		heartbeat::current().advance();
+		++laps;
+	};
+
+	named_task task{"my_beating_task", ref(task_function)};
+	ASSERT_TRUE(task.start().get());
+	while(laps < 10)
+		this_thread::sleep_for(chrono::milliseconds{1});
+	task.stop().wait();
+
+	ASSERT_LE(10, task.pulse().progress());
+	ASSERT_EQ(0, heartbeat::current().progress());
+}
@@ -0,0 +1,116 @@
+/*
+ * test_job_pool.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Georgios Dimitriadis
+ *
+ * Copyright (C) 2026 Georgios Dimitriadis
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ *   The above copyright notice and this permission notice shall be
+ *   included in all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#include "task_control/job_pool.h"
+#include "task_control/task_batch.h"
+#include <gtest/gtest.h>
+#include <atomic>
+#include <stdexcept>
+
+using namespace std;
+using namespace task_control;
+
+namespace {
+
+unsigned long fibonacci(job_pool& jobs, unsigned n) {
+	if(n < 2)
+		return n;
+	unsigned long smaller = 0;
+	job_group group{jobs};
+	group.fork([&] { smaller = fibonacci(jobs, n - 2); });
+	auto larger = fibonacci(jobs, n - 1);
+	group.join();
+	return smaller + larger;
+}
+
+}
+
+TEST(test_job_pool, parallel_for_in_a_batch) {
+	job_pool jobs{4};
+	task_batch batch;
+	batch.add(unique_ptr<named_task>{new named_task{"my_job_pool", ref(jobs)}});
+	ASSERT_TRUE(batch.start(chrono::milliseconds{1000}).succeeded());
+
+	vector<int> visits(100000, 0);
+	jobs.parallel_for(0, visits.size(), 1000, [&](size_t first, size_t last) {
+		for(auto i=first; i<last; ++i)
+			++visits[i];
+	});
+	for(auto visited : visits)
+		ASSERT_EQ(1, visited);
+
+	ASSERT_TRUE(batch.stop(chrono::milliseconds{1000}).succeeded());
+	ASSERT_EQ(4, jobs.size());
+}
+
+TEST(test_job_pool, fork_join_from_a_named_task) {
+	job_pool jobs{3};
+	unsigned long result = 0;
+	auto user = [&](named_task::init_callback_t init, const stop_token& stop) {
+		init(true);
+		result = fibonacci(jobs, 20);
+		stop.wait();
+	};
+
+	task_batch batch;
+	batch.add(unique_ptr<named_task>{new named_task{"my_job_pool", ref(jobs)}});
+	batch.add(unique_ptr<named_task>{new named_task{"my_job_user", user}});
+	ASSERT_TRUE(batch.start(chrono::milliseconds{1000}).succeeded());
+	ASSERT_TRUE(batch.stop(chrono::milliseconds{5000}).succeeded());
+	ASSERT_EQ(6765, result);
+}
+
+TEST(test_job_pool, join_rethrows) {
+	job_pool jobs{2};
+	named_task task{"my_job_pool", ref(jobs)};
+	ASSERT_TRUE(task.start().get());
+
+	atomic<int> ran{0};
+	job_group group{jobs};
+	for(int i=0; i<10; ++i) {
+		group.fork([&ran, i] {
+			++ran;
+			if(i == 5)
+				throw runtime_error("job failed");
+		});
+	}
+	ASSERT_THROW(group.join(), runtime_error);
+	ASSERT_EQ(10, ran);
+	group.join();
+
+	task.stop().get();
+}
+
+TEST(test_job_pool, joins_while_stopped) {
+	job_pool jobs{2};
+	ASSERT_EQ(6765, fibonacci(jobs, 20));
+
+	named_task task{"my_job_pool", ref(jobs)};
+	ASSERT_TRUE(task.start().get());
+	ASSERT_EQ(6765, fibonacci(jobs, 20));
+	task.stop().get();
+	ASSERT_EQ(6765, fibonacci(jobs, 20));
+}
@@ -0,0 +1,98 @@
+/*
+ * test_stop_token.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Georgios Dimitriadis
+ *
+ * Copyright (C) 2026 Georgios Dimitriadis
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ *   The above copyright notice and this permission notice shall be
+ *   included in all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#include "task_control/stop_token.h"
+#include "task_control/task_batch.h"
+#include <gtest/gtest.h>
+#include <atomic>
+#include <thread>
+#include <poll.h>
+
+using namespace std;
+using namespace task_control;
+
+TEST(test_stop_token, wait_wakes_on_request) {
+	stop_token token;
+	ASSERT_FALSE(token.stop_requested());
+	ASSERT_FALSE(token.wait_for(chrono::milliseconds{1}));
+
+	auto begin = chrono::steady_clock::now();
+	thread waiter{[&] { token.wait(); }};
+	this_thread::sleep_for(chrono::milliseconds{10});
+	token.request_stop();
+	waiter.join();
+	ASSERT_LT(chrono::steady_clock::now() - begin, chrono::seconds{1});
+	ASSERT_TRUE(token.stop_requested());
+	ASSERT_TRUE(static_cast<bool>(token));
+	ASSERT_TRUE(token.wait_for(chrono::hours{1}));
+}
+
+TEST(test_stop_token, callbacks) {
+	stop_token token;
+	int called = 0;
+	token.on_stop([&] { ++called; });
+	auto removed = token.on_stop([&] { called += 100; });
+	token.remove_on_stop(removed);
+
+	token.request_stop();
+	token.request_stop();
+	ASSERT_EQ(1, called);
+
+	token.on_stop([&] { ++called; });
+	ASSERT_EQ(2, called);
+}
+
+TEST(test_stop_token, eventfd_becomes_readable) {
+	stop_token token;
+	pollfd pfd{token.fd(), POLLIN, 0};
+	ASSERT_EQ(0, ::poll(&pfd, 1, 0));
+
+	token.request_stop();
+	ASSERT_EQ(1, ::poll(&pfd, 1, 0));
+
+	token.reset();
+	ASSERT_FALSE(token.stop_requested());
+	ASSERT_EQ(0, ::poll(&pfd, 1, 0));
+}
+
+TEST(test_stop_token, batch_stop_does_not_wait_for_polls) {
+	task_batch batch;
+	for(int i=0; i<100; ++i) {
+		batch.add(unique_ptr<named_task>{new named_task{"blocked_" + to_string(i),
+			[] (named_task::init_callback_t init_callback, const stop_token& stop) {
+				init_callback(true);
+				stop.wait_for(chrono::hours{1});
+			}}});
+	}
+	atomic<int> failures{0};
+	auto report = [&](const named_task&) { ++failures; };
+	batch.start(chrono::milliseconds{5000}, report);
+
+	auto begin = chrono::steady_clock::now();
+	batch.stop(chrono::milliseconds{5000}, report);
+	ASSERT_LT(chrono::steady_clock::now() - begin, chrono::milliseconds{500});
+	ASSERT_EQ(0, failures);
+}
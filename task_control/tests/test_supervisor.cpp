@@ -0,0 +1,181 @@
+/*
+ * test_supervisor.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Georgios Dimitriadis
+ *
+ * Copyright (C) 2026 Georgios Dimitriadis
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ *   The above copyright notice and this permission notice shall be
+ *   included in all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#include "task_control/supervisor.h"
+#include "task_control/task_batch_stack.h"
+#include <gtest/gtest.h>
+#include <atomic>
+#include <set>
+#include <stdexcept>
+
+using namespace std;
+using namespace task_control;
+
+namespace {
+
+const supervisor::policy quick_one_for_one{supervisor::strategy::one_for_one,
+	chrono::milliseconds{1}, chrono::milliseconds{10}, 0.5, 10, chrono::seconds{10}};
+
+bool eventually(function<bool()> condition) {
+	auto deadline = chrono::steady_clock::now() + chrono::seconds{5};
+	while(!condition()) {
+		if(chrono::steady_clock::now() > deadline)
+			return false;
+		this_thread::sleep_for(chrono::milliseconds{1});
+	}
+	return true;
+}
+
+// Throws right after init on its first runs, then runs until stopped.
+struct flaky_function {
+	explicit flaky_function(int failures) : failures{failures}, runs{0} { }
+
+	void operator () (named_task::init_callback_t init, const stop_token& stop) {
+		{
+			lock_guard<mutex> lock{mutex_};
+			threads.insert(this_thread::get_id());
+		}
+		init(true);
+		if(runs++ < failures)
+			throw runtime_error("flaky");
+		stop.wait();
+	}
+
+	const int failures;
+	atomic<int> runs;
+	set<thread::id> threads;
+	mutex mutex_;
+};
+
+}
+
+TEST(test_supervisor, one_for_one_restarts_in_place) {
+	flaky_function flaky{2};
+	task_batch batch;
+	batch.add(unique_ptr<named_task>{new named_task{"my_flaky_task", ref(flaky)}});
+	supervisor guard{batch, quick_one_for_one};
+
+	ASSERT_TRUE(batch.start(chrono::milliseconds{1000}).succeeded());
+	ASSERT_TRUE(eventually([&] { return flaky.runs == 3; }));
+
+	batch.for_each([](const named_task& task) {
+		ASSERT_TRUE(task.running());
+		ASSERT_EQ(2, task.restarts());
+	});
+	ASSERT_EQ(2, guard.restarts());
+	ASSERT_FALSE(guard.gave_up());
+	ASSERT_EQ(1, flaky.threads.size());
+	ASSERT_TRUE(batch.stop(chrono::milliseconds{1000}).succeeded());
+}
+
+TEST(test_supervisor, gives_up_beyond_intensity) {
+	flaky_function flaky{1000};
+	named_task* watched{nullptr};
+	task_batch batch;
+	{
+		unique_ptr<named_task> task{new named_task{"my_failing_task", ref(flaky)}};
+		watched = task.get();
+		batch.add(move(task));
+	}
+	vector<string> reported;
+	auto rules = quick_one_for_one;
+	rules.max_restarts = 3;
+	supervisor guard{batch, rules, [&](const named_task& task, exception_ptr failure) {
+		ASSERT_TRUE(static_cast<bool>(failure));
+		reported.push_back(task.name());
+	}};
+
+	ASSERT_TRUE(batch.start(chrono::milliseconds{1000}).succeeded());
+	ASSERT_TRUE(eventually([&] { return !watched->running(); }));
+	ASSERT_EQ(4, flaky.runs);
+	ASSERT_EQ(3, guard.restarts());
+	ASSERT_TRUE(guard.gave_up());
+	ASSERT_EQ(1, reported.size());
+	ASSERT_THROW(watched->stop().get(), runtime_error);
+}
+
+TEST(test_supervisor, one_for_all_restarts_the_rest) {
+	flaky_function flaky{1};
+	flaky_function steady{0};
+	task_batch batch;
+	batch.add(unique_ptr<named_task>{new named_task{"my_flaky_task", ref(flaky)}});
+	batch.add(unique_ptr<named_task>{new named_task{"my_steady_task", ref(steady)}});
+	auto rules = quick_one_for_one;
+	rules.restart = supervisor::strategy::one_for_all;
+	supervisor guard{batch, rules};
+
+	ASSERT_TRUE(batch.start(chrono::milliseconds{1000}).succeeded());
+	ASSERT_TRUE(eventually([&] { return flaky.runs == 2 && steady.runs == 2; }));
+	ASSERT_EQ(1, guard.restarts());
+	ASSERT_TRUE(batch.stop(chrono::milliseconds{1000}).succeeded());
+	ASSERT_EQ(2, steady.runs);
+}
+
+TEST(test_supervisor, exponential_backoff) {
+	flaky_function flaky{3};
+	task_batch batch;
+	batch.add(unique_ptr<named_task>{new named_task{"my_flaky_task", ref(flaky)}});
+	supervisor guard{batch, supervisor::policy{supervisor::strategy::one_for_one,
+		chrono::milliseconds{20}, chrono::milliseconds{1000}, 0.0, 10, chrono::seconds{10}}};
+
+	auto begin = chrono::steady_clock::now();
+	ASSERT_TRUE(batch.start(chrono::milliseconds{1000}).succeeded());
+	ASSERT_TRUE(eventually([&] { return flaky.runs == 4; }));
+	// 20 + 40 + 80 ms
+	ASSERT_LE(chrono::milliseconds{140}, chrono::steady_clock::now() - begin);
+	ASSERT_TRUE(batch.stop(chrono::milliseconds{1000}).succeeded());
+}
+
+TEST(test_supervisor, stop_during_backoff) {
+	flaky_function flaky{1};
+	task_batch batch;
+	batch.add(unique_ptr<named_task>{new named_task{"my_flaky_task", ref(flaky)}});
+	supervisor guard{batch, supervisor::policy{supervisor::strategy::one_for_one,
+		chrono::seconds{100}, chrono::seconds{100}, 0.0, 10, chrono::seconds{10}}};
+
+	ASSERT_TRUE(batch.start(chrono::milliseconds{1000}).succeeded());
+	ASSERT_TRUE(eventually([&] { return guard.restarts() == 1; }));
+	ASSERT_TRUE(batch.stop(chrono::milliseconds{1000}).succeeded());
+	ASSERT_EQ(1, flaky.runs);
+}
+
+TEST(test_supervisor, keeps_to_tasks_of_a_moved_batch) {
+	flaky_function flaky{1};
+	flaky_function steady{0};
+	task_batch batch;
+	batch.add(unique_ptr<named_task>{new named_task{"my_flaky_task", ref(flaky)}});
+	batch.add(unique_ptr<named_task>{new named_task{"my_steady_task", ref(steady)}});
+	auto rules = quick_one_for_one;
+	rules.restart = supervisor::strategy::one_for_all;
+	supervisor guard{batch, rules};
+	task_batch_stack stack;
+	stack.push_top(move(batch));
+
+	ASSERT_EQ(1, stack.set_level(1));
+	ASSERT_TRUE(eventually([&] { return flaky.runs == 2 && steady.runs == 2; }));
+	ASSERT_EQ(1, guard.restarts());
+	ASSERT_EQ(0, stack.set_level(0));
+}
@@ -155,3 +155,84 @@ TEST(test_task_batch, one_out_of_two_fails_inspection) {
 	ASSERT_EQ(1, failures.size()); // check that all report a good start
 	ASSERT_EQ("my_simple_task_1", failures[0]);
 }
+
+TEST(test_task_batch, outcomes_in_completion_order) {
+	task_batch batch;
+
+	testing_task_function slow_function;
+	slow_function.pre_lock = [] { this_thread::sleep_for(chrono::milliseconds{30}); };
+	testing_task_function fast_function;
+
+	batch.add(unique_ptr<named_task>{new named_task{"my_slow_task", ref(slow_function)}});
+	batch.add(unique_ptr<named_task>{new named_task{"my_fast_task", ref(fast_function)}});
+	auto started = batch.start(chrono::milliseconds{1000});
+
+	ASSERT_TRUE(started.succeeded());
+	ASSERT_EQ(2, started.outcomes.size());
+	ASSERT_EQ("my_fast_task", started.outcomes[0].task->name());
+	ASSERT_EQ("my_slow_task", started.outcomes[1].task->name());
+	ASSERT_LE(chrono::milliseconds{30}, started.outcomes[1].latency);
+
+	auto stopped = batch.stop(chrono::milliseconds{1000});
+	ASSERT_TRUE(stopped.succeeded());
+	ASSERT_EQ(2, stopped.count(task_outcome::status::succeeded));
+}
+
+TEST(test_task_batch, failure_reported_before_slow_init) {
+	task_batch batch;
+
+	testing_task_function slow_function;
+	slow_function.pre_lock = [] { this_thread::sleep_for(chrono::milliseconds{300}); };
+	testing_task_function failing_function;
+	failing_function.succeed_start = false;
+
+	batch.add(unique_ptr<named_task>{new named_task{"my_slow_task", ref(slow_function)}});
+	batch.add(unique_ptr<named_task>{new named_task{"my_failing_task", ref(failing_function)}});
+
+	auto begin = chrono::steady_clock::now();
+	chrono::steady_clock::duration reported_after{};
+	auto failure_reporter = [&](const named_task&) { reported_after = chrono::steady_clock::now() - begin; };
+	auto started = batch.start(chrono::milliseconds{1000}, failure_reporter);
+
+	ASSERT_LT(reported_after, chrono::milliseconds{300});
+	ASSERT_FALSE(started.succeeded());
+	ASSERT_EQ(task_outcome::status::failed, started.outcomes[0].result);
+	ASSERT_EQ(task_outcome::status::succeeded, started.outcomes[1].result);
+	batch.stop(chrono::milliseconds{1000});
+}
+
+TEST(test_task_batch, fail_fast_stops_waiting) {
+	task_batch batch;
+
+	testing_task_function slow_function;
+	slow_function.pre_lock = [] { this_thread::sleep_for(chrono::milliseconds{300}); };
+	testing_task_function failing_function;
+	failing_function.succeed_start = false;
+
+	batch.add(unique_ptr<named_task>{new named_task{"my_slow_task", ref(slow_function)}});
+	batch.add(unique_ptr<named_task>{new named_task{"my_failing_task", ref(failing_function)}});
+
+	vector<string> failures;
+	auto failure_reporter = [&](const named_task& task) { failures.push_back(task.name()); };
+	auto begin = chrono::steady_clock::now();
+	auto started = batch.start(chrono::milliseconds{1000}, failure_reporter, task_batch::wait_policy::fail_fast);
+
+	ASSERT_LT(chrono::steady_clock::now() - begin, chrono::milliseconds{300});
+	ASSERT_EQ(1, failures.size());
+	ASSERT_EQ("my_failing_task", failures[0]);
+	ASSERT_EQ(1, started.count(task_outcome::status::failed));
+	ASSERT_EQ(1, started.count(task_outcome::status::abandoned));
+	ASSERT_TRUE(batch.stop(chrono::milliseconds{1000}).succeeded());
+}
+
+TEST(test_task_batch, timed_out_init) {
+	task_batch batch;
+	testing_task_function task_function;
+	task_function.timeout_start = true;
+	batch.add(unique_ptr<named_task>{new named_task{"my_silent_task", ref(task_function)}});
+
+	auto started = batch.start(chrono::milliseconds{10});
+	ASSERT_EQ(1, started.count(task_outcome::status::timed_out));
+	ASSERT_LE(chrono::milliseconds{10}, started.outcomes[0].latency);
+	batch.stop(chrono::milliseconds{1000});
+}
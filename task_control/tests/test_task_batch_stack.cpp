@@ -28,6 +28,7 @@
 #include "task_control/task_batch_stack.h"
 #include "task_control/tests/testing_task_function.h"
 #include <gtest/gtest.h>
+#include <future>
 
 using namespace task_control;
 using namespace std;
@@ -153,3 +154,106 @@ TEST(test_task_batch_stack, six_tasks_in_three_batches) {
 	ASSERT_EQ(0,stack.inspect(chrono::milliseconds{10}));
 }
 
+
+TEST(test_task_batch_stack, lowers_and_raises_the_same_batches) {
+	vector<testing_task_function> task_functions{2};
+	vector<task_batch> batches{2};
+	for(int i=0; i<2; ++i) {
+		task_functions[i].run_for = chrono::milliseconds{100000};
+		batches[i].add(unique_ptr<named_task>{new named_task{"my_simple_task_" + to_string(i), ref(task_functions[i])}});
+	}
+	atomic<int> bottom_starts{0};
+	task_functions[0].pre_lock = [&] { ++bottom_starts; };
+
+	task_batch_stack stack;
+	stack.push_top(move(batches[0]));
+	stack.push_top(move(batches[1]));
+
+	ASSERT_EQ(2,stack.set_level(2));
+	ASSERT_EQ(0,stack.set_level(0));
+	ASSERT_EQ(1,stack.set_level(1));
+	ASSERT_EQ(2,bottom_starts);
+	ASSERT_EQ(0,stack.set_level(0));
+}
+
+TEST(test_task_batch_stack, async_level_change) {
+	vector<testing_task_function> task_functions{2};
+	vector<task_batch> batches{2};
+	for(int i=0; i<2; ++i) {
+		task_functions[i].run_for = chrono::milliseconds{100000};
+		task_functions[i].pre_lock = [] { this_thread::sleep_for(chrono::milliseconds{30}); };
+		batches[i].add(unique_ptr<named_task>{new named_task{"my_simple_task_" + to_string(i), ref(task_functions[i])}});
+	}
+
+	task_batch_stack stack;
+	stack.push_top(move(batches[0]));
+	stack.push_top(move(batches[1]));
+
+	promise<int> reported;
+	auto reached = stack.set_level_async(2, chrono::milliseconds::zero(), [&](int level) { reported.set_value(level); });
+	ASSERT_EQ(future_status::timeout, reached.wait_for(chrono::milliseconds{0}));
+	ASSERT_EQ(future_status::ready, reached.wait_for(chrono::seconds{5}));
+	ASSERT_EQ(2,reached.get());
+	ASSERT_EQ(2,reported.get_future().get());
+	ASSERT_EQ(2,stack.inspect(chrono::milliseconds{10}));
+
+	ASSERT_EQ(0,stack.set_level_async(0).get());
+}
+
+TEST(test_task_batch_stack, newer_target_preempts_transition) {
+	vector<testing_task_function> task_functions{3};
+	vector<task_batch> batches{3};
+	for(int i=0; i<3; ++i) {
+		task_functions[i].run_for = chrono::milliseconds{100000};
+		task_functions[i].pre_lock = [] { this_thread::sleep_for(chrono::milliseconds{50}); };
+		batches[i].add(unique_ptr<named_task>{new named_task{"my_simple_task_" + to_string(i), ref(task_functions[i])}});
+	}
+
+	task_batch_stack stack;
+	for(auto& batch : batches)
+		stack.push_top(move(batch));
+
+	auto up = stack.set_level_async(3);
+	this_thread::sleep_for(chrono::milliseconds{20});
+	auto down = stack.set_level_async(0);
+
+	ASSERT_EQ(1,up.get());
+	ASSERT_EQ(0,down.get());
+	ASSERT_EQ(0,stack.level());
+}
+
+TEST(test_task_batch_stack, per_batch_and_per_call_timeouts) {
+	testing_task_function task_function;
+	task_function.timeout_start = true;
+	task_batch batch;
+	batch.add(unique_ptr<named_task>{new named_task{"my_silent_task", ref(task_function)}});
+
+	task_batch_stack stack;
+	stack.push_top(move(batch), chrono::milliseconds{20}, chrono::milliseconds{20});
+
+	auto begin = chrono::steady_clock::now();
+	ASSERT_EQ(0,stack.set_level_async(1).get());
+	ASSERT_LT(chrono::steady_clock::now() - begin, chrono::milliseconds{500});
+
+	begin = chrono::steady_clock::now();
+	ASSERT_EQ(0,stack.set_level_async(1, chrono::milliseconds{10}).get());
+	ASSERT_LT(chrono::steady_clock::now() - begin, chrono::milliseconds{500});
+}
+
+TEST(test_task_batch_stack, inspect_does_not_hold_up_level_changes) {
+	testing_task_function task_function;
+	task_function.run_for = chrono::milliseconds{100000};
+	task_batch batch;
+	batch.add(unique_ptr<named_task>{new named_task{"my_long_task", ref(task_function)}});
+
+	task_batch_stack stack;
+	stack.push_top(move(batch));
+	ASSERT_EQ(1,stack.set_level(1));
+
+	auto inspected = async(launch::async, [&] { return stack.inspect(chrono::milliseconds{5000}); });
+	this_thread::sleep_for(chrono::milliseconds{20});
+	auto begin = chrono::steady_clock::now();
+	ASSERT_EQ(0,stack.set_level(0));
+	ASSERT_LT(chrono::steady_clock::now() - begin, chrono::milliseconds{2000});
+	ASSERT_EQ(0,inspected.get());
+}
@@ -0,0 +1,100 @@
+/*
+ * test_task_executor.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Georgios Dimitriadis
+ *
+ * Copyright (C) 2026 Georgios Dimitriadis
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ *   The above copyright notice and this permission notice shall be
+ *   included in all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#include "task_control/task_executor.h"
+#include "task_control/named_task.h"
+#include "task_control/tests/testing_task_function.h"
+#include <gtest/gtest.h>
+#include <atomic>
+#include <set>
+
+using namespace std;
+using namespace task_control;
+
+TEST(test_task_executor, runs_submitted_jobs) {
+	atomic<int> done{0};
+	{
+		task_executor executor{4};
+		ASSERT_EQ(4u, executor.size());
+		for(int i=0; i<100; ++i)
+			executor.submit([&] { ++done; });
+	}
+	ASSERT_EQ(100, done);
+}
+
+TEST(test_task_executor, custom_stack_size) {
+	task_executor executor{1, 256*1024};
+	promise<size_t> stack_size;
+	executor.submit([&] {
+		pthread_attr_t attr;
+		size_t size = 0;
+		pthread_getattr_np(pthread_self(), &attr);
+		pthread_attr_getstacksize(&attr, &size);
+		pthread_attr_destroy(&attr);
+		stack_size.set_value(size);
+	});
+	ASSERT_EQ(256u*1024, stack_size.get_future().get());
+}
+
+TEST(test_task_executor, restarted_task_reuses_worker) {
+	task_executor executor{1};
+	set<thread::id> threads;
+	mutex threads_mutex;
+	testing_task_function task_function;
+	task_function.run_for = chrono::seconds{10};
+	task_function.lap_callback = [&](int) {
+		lock_guard<mutex> lock{threads_mutex};
+		threads.insert(this_thread::get_id());
+	};
+	task_function.min_laps = 1;
+	named_task task{"pooled_task", ref(task_function), executor};
+
+	for(int i=0; i<3; ++i) {
+		ASSERT_TRUE(task.start().get());
+		auto result = task.stop();
+		ASSERT_EQ(future_status::ready, result.wait_for(chrono::seconds{1}));
+		result.get();
+	}
+	ASSERT_EQ(1u, threads.size());
+}
+
+TEST(test_task_executor, task_waits_for_free_worker) {
+	task_executor executor{1};
+	testing_task_function first_function, second_function;
+	first_function.run_for = second_function.run_for = chrono::seconds{10};
+	named_task first{"first", ref(first_function), executor};
+	named_task second{"second", ref(second_function), executor};
+
+	ASSERT_TRUE(first.start().get());
+	auto second_started = second.start();
+	ASSERT_EQ(future_status::timeout, second_started.wait_for(chrono::milliseconds{50}));
+	ASSERT_EQ(0u, executor.idle());
+
+	first.stop().wait();
+	ASSERT_EQ(future_status::ready, second_started.wait_for(chrono::seconds{1}));
+	ASSERT_TRUE(second_started.get());
+	second.stop().wait();
+}
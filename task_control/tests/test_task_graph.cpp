@@ -0,0 +1,149 @@
+/*
+ * test_task_graph.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Georgios Dimitriadis
+ *
+ * Copyright (C) 2026 Georgios Dimitriadis
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ *   The above copyright notice and this permission notice shall be
+ *   included in all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#include "task_control/task_graph.h"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <mutex>
+
+using namespace std;
+using namespace task_control;
+
+struct test_task_graph : ::testing::Test {
+	// Tasks log "+name" once up and "-name" when they exit.
+	unique_ptr<named_task> make_task(const string& name, chrono::milliseconds init_time=chrono::milliseconds{0}, bool succeed=true) {
+		return unique_ptr<named_task>{new named_task{name,
+			[=] (named_task::init_callback_t init_callback, const stop_token& stop) {
+				this_thread::sleep_for(init_time);
+				if(succeed)
+					record("+" + name);
+				init_callback(succeed);
+				if(!succeed)
+					return;
+				stop.wait();
+				record("-" + name);
+			}}};
+	}
+
+	void record(const string& event) {
+		lock_guard<mutex> lock{events_mutex};
+		events.push_back(event);
+	}
+
+	size_t position(const string& event) {
+		lock_guard<mutex> lock{events_mutex};
+		return static_cast<size_t>(find(events.begin(), events.end(), event) - events.begin());
+	}
+
+	vector<string> reported(task_graph& graph, bool start) {
+		vector<string> names;
+		auto report = [&](const named_task& task) { names.push_back(task.name()); };
+		if(start)
+			graph.start(chrono::milliseconds{2000}, report);
+		else
+			graph.stop(chrono::milliseconds{2000}, report);
+		sort(names.begin(), names.end());
+		return names;
+	}
+
+	mutex events_mutex;
+	vector<string> events;
+};
+
+TEST_F(test_task_graph, starts_after_dependencies_and_stops_before_them) {
+	task_graph graph;
+	graph.add(make_task("db"));
+	graph.add(make_task("cache"));
+	graph.add(make_task("api", chrono::milliseconds{0}), {"db", "cache"});
+	graph.add(make_task("metrics"), {"db"});
+
+	ASSERT_TRUE(graph.start(chrono::milliseconds{2000}));
+	ASSERT_TRUE(graph.running("api"));
+	ASSERT_LT(position("+db"), position("+api"));
+	ASSERT_LT(position("+cache"), position("+api"));
+	ASSERT_LT(position("+db"), position("+metrics"));
+
+	ASSERT_TRUE(graph.stop(chrono::milliseconds{2000}));
+	ASSERT_FALSE(graph.running("db"));
+	ASSERT_LT(position("-api"), position("-db"));
+	ASSERT_LT(position("-api"), position("-cache"));
+	ASSERT_LT(position("-metrics"), position("-db"));
+}
+
+TEST_F(test_task_graph, independent_chains_start_in_parallel) {
+	task_graph graph;
+	const chrono::milliseconds init_time{40};
+	for(const string chain : {"a", "b", "c"}) {
+		graph.add(make_task(chain + "1", init_time));
+		graph.add(make_task(chain + "2", init_time), {chain + "1"});
+	}
+
+	auto begin = chrono::steady_clock::now();
+	ASSERT_TRUE(graph.start(chrono::milliseconds{2000}));
+	// Two inits in a row, where one batch per task would take six.
+	ASSERT_LT(chrono::steady_clock::now() - begin, 4 * init_time);
+	ASSERT_TRUE(graph.stop(chrono::milliseconds{2000}));
+}
+
+TEST_F(test_task_graph, failed_init_skips_dependents) {
+	task_graph graph;
+	graph.add(make_task("db", chrono::milliseconds{0}, false));
+	graph.add(make_task("cache"));
+	graph.add(make_task("api"), {"db", "cache"});
+	graph.add(make_task("web"), {"api"});
+
+	ASSERT_EQ((vector<string>{"api", "db", "web"}), reported(graph, true));
+	ASSERT_TRUE(graph.running("cache"));
+	ASSERT_FALSE(graph.running("api"));
+	ASSERT_EQ(events.end(), find(events.begin(), events.end(), "+api"));
+
+	ASSERT_TRUE(reported(graph, false).empty());
+	ASSERT_FALSE(graph.running("cache"));
+}
+
+TEST_F(test_task_graph, layers_start_one_after_another) {
+	task_graph graph;
+	vector<unique_ptr<named_task>> bottom, top;
+	bottom.push_back(make_task("bottom_1", chrono::milliseconds{20}));
+	bottom.push_back(make_task("bottom_2"));
+	top.push_back(make_task("top_1"));
+	graph.add_layer(move(bottom));
+	graph.add_layer(move(top));
+
+	ASSERT_TRUE(graph.start(chrono::milliseconds{2000}));
+	ASSERT_LT(position("+bottom_1"), position("+top_1"));
+	ASSERT_LT(position("+bottom_2"), position("+top_1"));
+	ASSERT_TRUE(graph.stop(chrono::milliseconds{2000}));
+	ASSERT_LT(position("-top_1"), position("-bottom_1"));
+}
+
+TEST_F(test_task_graph, rejects_unknown_dependency) {
+	task_graph graph;
+	graph.add(make_task("db"));
+	ASSERT_THROW(graph.add(make_task("api"), {"dbx"}), invalid_argument);
+	ASSERT_THROW(graph.add(make_task("db")), invalid_argument);
+	ASSERT_EQ(1u, graph.size());
+}
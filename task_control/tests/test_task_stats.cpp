@@ -0,0 +1,130 @@
+/*
+ * test_task_stats.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Georgios Dimitriadis
+ *
+ * Copyright (C) 2026 Georgios Dimitriadis
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ *   The above copyright notice and this permission notice shall be
+ *   included in all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#include "task_control/task_batch_stack.h"
+#include "task_control/tests/testing_task_function.h"
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <time.h>
+
+using namespace std;
+using namespace task_control;
+
+namespace {
+
+chrono::nanoseconds thread_cpu_time() {
+	timespec spent;
+	clock_gettime(CLOCK_THREAD_CPUTIME_ID, &spent);
+	return chrono::seconds{spent.tv_sec} + chrono::nanoseconds{spent.tv_nsec};
+}
+
+}
+
+TEST(test_task_stats, latencies_and_cpu_time) {
+	auto burner = [](named_task::init_callback_t init, const stop_token& stop) {
+		this_thread::sleep_for(chrono::milliseconds{20});
+		init(true);
+		auto begin = thread_cpu_time();
+		while(thread_cpu_time() - begin < chrono::milliseconds{30})
+			;
+		stop.wait();
+	};
+	named_task task{"my_burning_task", burner};
+
+	auto before = task.stats();
+	ASSERT_EQ("my_burning_task", before.name);
+	ASSERT_FALSE(before.running);
+	ASSERT_EQ(0, before.starts);
+
+	ASSERT_TRUE(task.start().get());
+	auto started = task.stats();
+	ASSERT_TRUE(started.running);
+	ASSERT_EQ(1, started.starts);
+	ASSERT_LE(chrono::milliseconds{20}, started.init_latency);
+
+	this_thread::sleep_for(chrono::milliseconds{100});
+	auto burning = task.stats();
+	ASSERT_LE(chrono::milliseconds{30}, burning.cpu_time);
+	ASSERT_LE(burning.cpu_time, burning.run_time);
+
+	task.stop().get();
+	auto stopped = task.stats();
+	ASSERT_FALSE(stopped.running);
+	ASSERT_LT(chrono::nanoseconds::zero(), stopped.stop_latency);
+	ASSERT_LE(chrono::milliseconds{30}, stopped.cpu_time);
+	ASSERT_EQ(stopped.run_time, task.stats().run_time);
+	ASSERT_FALSE(static_cast<bool>(stopped.last_exception));
+}
+
+TEST(test_task_stats, last_exception) {
+	auto thrower = [](named_task::init_callback_t init, const stop_token&) {
+		init(true);
+		throw runtime_error("boom");
+	};
+	named_task task{"my_throwing_task", thrower};
+	ASSERT_TRUE(task.start().get());
+	auto result = task.stop();
+	ASSERT_THROW(result.get(), runtime_error);
+
+	auto stats = task.stats();
+	ASSERT_EQ(1, stats.failures);
+	ASSERT_EQ(0, stats.restarts);
+	ASSERT_THROW(rethrow_exception(stats.last_exception), runtime_error);
+}
+
+TEST(test_task_stats, across_the_stack) {
+	vector<testing_task_function> task_functions{3};
+	vector<task_batch> batches{2};
+	for(size_t i=0; i<task_functions.size(); ++i) {
+		task_functions[i].run_for = chrono::milliseconds{100000};
+		task_functions[i].pre_lock = [] { this_thread::sleep_for(chrono::milliseconds{50}); };
+		batches[i/2].add(unique_ptr<named_task>{new named_task{"my_simple_task_" + to_string(i), ref(task_functions[i])}});
+	}
+
+	task_batch_stack stack;
+	stack.push_top(move(batches[0]));
+	stack.push_top(move(batches[1]));
+
+	auto up = stack.set_level_async(1);
+	this_thread::sleep_for(chrono::milliseconds{10});
+	// The batch being started still shows up.
+	ASSERT_EQ(2, stack.stats().size());
+	ASSERT_EQ(1, up.get());
+
+	auto levels = stack.stats();
+	ASSERT_EQ(2, levels.size());
+	ASSERT_EQ(2, levels[0].size());
+	ASSERT_EQ(1, levels[1].size());
+	for(const auto& stats : levels[0]) {
+		ASSERT_TRUE(stats.running);
+		ASSERT_LE(chrono::milliseconds{50}, stats.init_latency);
+	}
+	ASSERT_EQ("my_simple_task_2", levels[1][0].name);
+	ASSERT_FALSE(levels[1][0].running);
+	ASSERT_EQ(0, levels[1][0].starts);
+
+	ASSERT_EQ(0, stack.set_level(0));
+}
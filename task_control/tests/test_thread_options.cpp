@@ -0,0 +1,136 @@
+/*
+ * test_thread_options.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Georgios Dimitriadis
+ *
+ * Copyright (C) 2026 Georgios Dimitriadis
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ *   The above copyright notice and this permission notice shall be
+ *   included in all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#include "task_control/task_batch_stack.h"
+#include <gtest/gtest.h>
+#include <stdexcept>
+
+using namespace std;
+using namespace task_control;
+
+namespace {
+
+// What the task's thread looks like from the inside.
+struct thread_probe {
+	thread_probe() : stack_size{0} { CPU_ZERO(&cpus); }
+
+	void operator () (named_task::init_callback_t init, const stop_token& stop) {
+		char buffer[16];
+		pthread_getname_np(pthread_self(), buffer, sizeof(buffer));
+		name = buffer;
+		pthread_getaffinity_np(pthread_self(), sizeof(cpus), &cpus);
+		pthread_attr_t attr;
+		pthread_getattr_np(pthread_self(), &attr);
+		pthread_attr_getstacksize(&attr, &stack_size);
+		pthread_attr_destroy(&attr);
+		init(true);
+		stop.wait();
+	}
+
+	string name;
+	cpu_set_t cpus;
+	size_t stack_size;
+};
+
+}
+
+TEST(test_thread_options, named_after_the_task) {
+	thread_probe probe;
+	named_task task{"my_long_winded_task_name", ref(probe)};
+	ASSERT_TRUE(task.start().get());
+	task.stop().get();
+	ASSERT_EQ("my_long_winded_", probe.name);
+}
+
+TEST(test_thread_options, pinned_with_stack_size) {
+	thread_probe probe;
+	thread_options options;
+	options.cpus = {0};
+	options.stack_size = 256 * 1024;
+	named_task task{"my_pinned_task", ref(probe), options};
+	ASSERT_TRUE(task.start().get());
+	task.stop().get();
+
+	ASSERT_EQ(1, CPU_COUNT(&probe.cpus));
+	ASSERT_TRUE(CPU_ISSET(0, &probe.cpus));
+	ASSERT_LE(options.stack_size, probe.stack_size);
+	ASSERT_GT(1024u * 1024u, probe.stack_size);
+}
+
+TEST(test_thread_options, batch_defaults) {
+	thread_probe default_probe;
+	thread_probe own_probe;
+	thread_options own;
+	own.name_thread = false;
+	own.stack_size = 512 * 1024;
+
+	task_batch batch;
+	batch.add(unique_ptr<named_task>{new named_task{"my_default_task", ref(default_probe)}});
+	batch.add(unique_ptr<named_task>{new named_task{"my_own_task", ref(own_probe), own}});
+	thread_options defaults;
+	defaults.stack_size = 256 * 1024;
+	batch.set_thread_options(defaults);
+
+	ASSERT_TRUE(batch.start(chrono::milliseconds{1000}).succeeded());
+	ASSERT_TRUE(batch.stop(chrono::milliseconds{1000}).succeeded());
+
+	ASSERT_EQ("my_default_task", default_probe.name);
+	ASSERT_GT(512u * 1024u, default_probe.stack_size);
+	ASSERT_NE("my_own_task", own_probe.name);
+	ASSERT_LE(own.stack_size, own_probe.stack_size);
+}
+
+TEST(test_thread_options, numa_node) {
+	auto cpus = numa_node_cpus(0);
+	ASSERT_FALSE(cpus.empty());
+	ASSERT_THROW(numa_node_cpus(100000), invalid_argument);
+
+	thread_options options;
+	options.numa_node = 100000;
+	thread_probe probe;
+	named_task task{"my_lost_task", ref(probe), options};
+	ASSERT_FALSE(task.start().get());
+	ASSERT_FALSE(task.running());
+	ASSERT_THROW(task.stop().get(), invalid_argument);
+}
+
+TEST(test_thread_options, unusable_options_fail_the_level) {
+	thread_probe probe;
+	task_batch batch;
+	batch.add(unique_ptr<named_task>{new named_task{"my_lost_task", ref(probe)}});
+	thread_options lost;
+	lost.numa_node = 100000;
+	batch.set_thread_options(lost);
+
+	task_batch_stack stack;
+	stack.push_top(move(batch));
+	ASSERT_EQ(0, stack.set_level(1));
+	ASSERT_EQ(0, stack.set_level_async(1).get());
+	auto levels = stack.stats();
+	ASSERT_EQ(1, levels.size());
+	ASSERT_EQ(1, levels[0].size());
+	ASSERT_FALSE(levels[0][0].running);
+}
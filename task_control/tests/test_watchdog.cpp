@@ -0,0 +1,135 @@
+/*
+ * test_watchdog.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Georgios Dimitriadis
+ *
+ * Copyright (C) 2026 Georgios Dimitriadis
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ *   The above copyright notice and this permission notice shall be
+ *   included in all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#include "task_control/watchdog.h"
+#include "task_control/task_batch_stack.h"
+#include "task_control/tests/testing_task_function.h"
+#include <gtest/gtest.h>
+#include <atomic>
+#include <map>
+
+using namespace std;
+using namespace task_control;
+
+namespace {
+
+map<string, watchdog::verdict> findings_of(const watchdog& dog, const task_batch& batch) {
+	map<string, watchdog::verdict> findings;
+	dog.check(batch, [&](const watchdog::finding& found) { findings[found.task->name()] = found.state; });
+	return findings;
+}
+
+}
+
+TEST(test_watchdog, exited_stalled_and_slow) {
+	testing_task_function progressing_function;
+	progressing_function.run_for = chrono::milliseconds{100000};
+	progressing_function.lap_callback = [](int) { heartbeat::current().advance(); };
+
+	testing_task_function spinning_function;
+	spinning_function.run_for = chrono::milliseconds{100000};
+	spinning_function.lap_callback = [](int) { heartbeat::current().beat(); };
+
+	testing_task_function silent_function;
+	silent_function.run_for = chrono::milliseconds{100000};
+
+	testing_task_function exiting_function;
+	exiting_function.run_for = chrono::microseconds{0};
+
+	task_batch batch;
+	batch.add(unique_ptr<named_task>{new named_task{"my_progressing_task", ref(progressing_function)}});
+	batch.add(unique_ptr<named_task>{new named_task{"my_spinning_task", ref(spinning_function)}});
+	batch.add(unique_ptr<named_task>{new named_task{"my_silent_task", ref(silent_function)}});
+	batch.add(unique_ptr<named_task>{new named_task{"my_exiting_task", ref(exiting_function)}});
+	ASSERT_TRUE(batch.start(chrono::milliseconds{1000}).succeeded());
+	this_thread::sleep_for(chrono::milliseconds{100});
+
+	// Slowness shows from the second check on.
+	watchdog slow_dog{chrono::milliseconds{50}, chrono::seconds{10}};
+	auto first = findings_of(slow_dog, batch);
+	ASSERT_EQ(1, first.size());
+	ASSERT_EQ(watchdog::verdict::exited, first["my_exiting_task"]);
+	this_thread::sleep_for(chrono::milliseconds{100});
+	auto slow = findings_of(slow_dog, batch);
+	ASSERT_EQ(3, slow.size());
+	ASSERT_EQ(watchdog::verdict::slow, slow["my_spinning_task"]);
+	ASSERT_EQ(watchdog::verdict::slow, slow["my_silent_task"]);
+	ASSERT_EQ(watchdog::verdict::exited, slow["my_exiting_task"]);
+
+	auto stalled = findings_of(watchdog{chrono::milliseconds{10}, chrono::milliseconds{50}}, batch);
+	ASSERT_EQ(2, stalled.size());
+	ASSERT_EQ(watchdog::verdict::stalled, stalled["my_silent_task"]);
+
+	auto exits_only = findings_of(watchdog{chrono::milliseconds::zero(), chrono::milliseconds::zero()}, batch);
+	ASSERT_EQ(1, exits_only.size());
+	ASSERT_EQ(watchdog::verdict::exited, exits_only["my_exiting_task"]);
+
+	batch.stop(chrono::milliseconds{1000});
+}
+
+TEST(test_watchdog, one_pass_does_not_wait) {
+	vector<testing_task_function> task_functions{50};
+	task_batch batch;
+	for(size_t i=0; i<task_functions.size(); ++i) {
+		task_functions[i].run_for = chrono::milliseconds{100000};
+		batch.add(unique_ptr<named_task>{new named_task{"my_simple_task_" + to_string(i), ref(task_functions[i])}});
+	}
+	ASSERT_TRUE(batch.start(chrono::milliseconds{5000}).succeeded());
+
+	auto begin = chrono::steady_clock::now();
+	ASSERT_EQ(0, watchdog(chrono::seconds{10}, chrono::seconds{10}).check(batch, nullptr));
+	ASSERT_LT(chrono::steady_clock::now() - begin, chrono::milliseconds{50});
+
+	batch.stop(chrono::milliseconds{5000});
+}
+
+TEST(test_watchdog, stack_level) {
+	testing_task_function healthy_function;
+	healthy_function.run_for = chrono::milliseconds{100000};
+	testing_task_function exiting_function;
+	exiting_function.run_for = chrono::microseconds{0};
+	testing_task_function top_function;
+	top_function.run_for = chrono::milliseconds{100000};
+
+	vector<task_batch> batches{3};
+	batches[0].add(unique_ptr<named_task>{new named_task{"my_healthy_task", ref(healthy_function)}});
+	batches[1].add(unique_ptr<named_task>{new named_task{"my_exiting_task", ref(exiting_function)}});
+	batches[2].add(unique_ptr<named_task>{new named_task{"my_top_task", ref(top_function)}});
+
+	task_batch_stack stack;
+	for(auto& batch : batches)
+		stack.push_top(move(batch));
+	ASSERT_EQ(3, stack.set_level(3));
+	this_thread::sleep_for(chrono::milliseconds{10});
+
+	vector<string> reported;
+	watchdog dog{chrono::milliseconds::zero(), chrono::milliseconds::zero()};
+	ASSERT_EQ(1, stack.check(dog, [&](const watchdog::finding& found) { reported.push_back(found.task->name()); }));
+	ASSERT_EQ(1, reported.size());
+	ASSERT_EQ("my_exiting_task", reported[0]);
+
+	ASSERT_EQ(0, stack.set_level(0));
+}
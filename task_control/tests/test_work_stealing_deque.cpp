@@ -0,0 +1,90 @@
+/*
+ * test_work_stealing_deque.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Georgios Dimitriadis
+ *
+ * Copyright (C) 2026 Georgios Dimitriadis
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ *   The above copyright notice and this permission notice shall be
+ *   included in all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#include "task_control/work_stealing_deque.h"
+#include <gtest/gtest.h>
+#include <atomic>
+#include <thread>
+
+using namespace std;
+using namespace task_control;
+
+TEST(test_work_stealing_deque, owner_lifo_thief_fifo) {
+	int items[4] = {0, 1, 2, 3};
+	work_stealing_deque<int*> deque{2};
+	ASSERT_TRUE(deque.empty());
+	ASSERT_EQ(nullptr, deque.pop());
+	ASSERT_EQ(nullptr, deque.steal());
+
+	for(auto& item : items)
+		deque.push(&item);
+	ASSERT_FALSE(deque.empty());
+	ASSERT_EQ(&items[3], deque.pop());
+	ASSERT_EQ(&items[0], deque.steal());
+	ASSERT_EQ(&items[2], deque.pop());
+	ASSERT_EQ(&items[1], deque.steal());
+	ASSERT_EQ(nullptr, deque.pop());
+	ASSERT_TRUE(deque.empty());
+}
+
+TEST(test_work_stealing_deque, every_item_taken_once) {
+	const int count = 200000;
+	vector<int> items(count);
+	vector<atomic<int>> taken(count);
+	for(int i=0; i<count; ++i) {
+		items[static_cast<size_t>(i)] = i;
+		taken[static_cast<size_t>(i)] = 0;
+	}
+
+	work_stealing_deque<int*> deque{4};
+	atomic<bool> done{false};
+	auto take = [&](int* item) { ++taken[static_cast<size_t>(*item)]; };
+	vector<thread> thieves;
+	for(int i=0; i<3; ++i) {
+		thieves.emplace_back([&] {
+			while(!done || !deque.empty()) {
+				if(auto item = deque.steal())
+					take(item);
+			}
+		});
+	}
+
+	for(int i=0; i<count; ++i) {
+		deque.push(&items[static_cast<size_t>(i)]);
+		if(i % 3 == 0) {
+			if(auto item = deque.pop())
+				take(item);
+		}
+	}
+	while(auto item = deque.pop())
+		take(item);
+	done = true;
+	for(auto& thief : thieves)
+		thief.join();
+
+	for(int i=0; i<count; ++i)
+		ASSERT_EQ(1, taken[static_cast<size_t>(i)]) << "item " << i;
+}
@@ -53,7 +53,7 @@ struct testing_task_function {
 		loop_mutex_.unlock();
 	}
 
-	void operator () (task_control::named_task::init_callback_t cb, const bool& stop) {
+	void operator () (task_control::named_task::init_callback_t cb, const task_control::stop_token& stop) {
 		pre_lock();
 		std::lock_guard<std::mutex> lock(loop_mutex_);
 		post_lock();
@@ -67,7 +67,9 @@ struct testing_task_function {
 				if(force_stop_)
 					break;
 				lap_callback(nLaps);
-				std::this_thread::sleep_for(std::chrono::microseconds{5});
+				// Once stopped, laps forced by min_laps or timeout_stop still pace themselves.
+				if(stop.wait_for(std::chrono::microseconds{5}))
+					std::this_thread::sleep_for(std::chrono::microseconds{5});
 			}
 		}
 		if (throw_on_exit)
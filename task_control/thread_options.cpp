@@ -0,0 +1,129 @@
+/*
+ * thread_options.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Georgios Dimitriadis
+ *
+ * Copyright (C) 2026 Georgios Dimitriadis
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ *   The above copyright notice and this permission notice shall be
+ *   included in all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#include <task_control/thread_options.h>
+#include <cerrno>
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <system_error>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+using namespace task_control;
+using namespace std;
+
+namespace {
+
+void* run_body(void* body) {
+	unique_ptr<function<void()>> owned{static_cast<function<void()>*>(body)};
+	(*owned)();
+	return nullptr;
+}
+
+void check(int error, const char* what) {
+	if(error)
+		throw system_error(error, system_category(), string("thread_options: ") + what);
+}
+
+}
+
+thread_options::thread_options()
+	: numa_node{-1},
+	  policy{SCHED_OTHER},
+	  priority{0},
+	  nice{0},
+	  stack_size{0},
+	  name_thread{true}
+{
+}
+
+pthread_t thread_options::spawn(function<void()> body) const {
+	vector<int> pinned{cpus};
+	if(numa_node >= 0) {
+		auto node_cpus = numa_node_cpus(numa_node);
+		pinned.insert(pinned.end(), node_cpus.begin(), node_cpus.end());
+	}
+
+	pthread_attr_t attr;
+	pthread_attr_init(&attr);
+	unique_ptr<pthread_attr_t, int(*)(pthread_attr_t*)> attr_guard{&attr, &pthread_attr_destroy};
+	if(stack_size)
+		check(pthread_attr_setstacksize(&attr, stack_size), "cannot set stack size");
+	if(!pinned.empty()) {
+		cpu_set_t set;
+		CPU_ZERO(&set);
+		for(auto cpu : pinned)
+			CPU_SET(static_cast<size_t>(cpu), &set);
+		check(pthread_attr_setaffinity_np(&attr, sizeof(set), &set), "cannot set CPU affinity");
+	}
+	if(policy != SCHED_OTHER) {
+		sched_param param;
+		param.sched_priority = priority;
+		check(pthread_attr_setinheritsched(&attr, PTHREAD_EXPLICIT_SCHED), "cannot set scheduling");
+		check(pthread_attr_setschedpolicy(&attr, policy), "cannot set scheduling policy");
+		check(pthread_attr_setschedparam(&attr, &param), "cannot set scheduling priority");
+	}
+
+	pthread_t thread;
+	unique_ptr<function<void()>> owned{new function<void()>{move(body)}};
+	check(pthread_create(&thread, &attr, &run_body, owned.get()), "cannot create thread");
+	owned.release();
+	return thread;
+}
+
+void thread_options::apply_here(const string& name) const {
+	if(name_thread)
+		pthread_setname_np(pthread_self(), name.substr(0, 15).c_str());
+	if(nice && policy == SCHED_OTHER) {
+		auto thread_id = static_cast<id_t>(syscall(SYS_gettid));
+		if(setpriority(PRIO_PROCESS, thread_id, nice) != 0)
+			check(errno, "cannot set nice level");
+	}
+}
+
+vector<int> task_control::numa_node_cpus(int node) {
+	ifstream list{"/sys/devices/system/node/node" + to_string(node) + "/cpulist"};
+	string ranges;
+	if(!getline(list, ranges))
+		throw invalid_argument("thread_options: no NUMA node " + to_string(node));
+
+	vector<int> cpus;
+	istringstream iss{ranges};
+	string range;
+	while(getline(iss, range, ',')) {
+		if(range.empty())
+			continue;
+		auto dash = range.find('-');
+		int first = stoi(range.substr(0, dash));
+		int last = dash == string::npos ? first : stoi(range.substr(dash + 1));
+		for(int cpu=first; cpu<=last; ++cpu)
+			cpus.push_back(cpu);
+	}
+	return cpus;
+}
@@ -0,0 +1,77 @@
+/*
+ * thread_options.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Georgios Dimitriadis
+ *
+ * Copyright (C) 2026 Georgios Dimitriadis
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ *   The above copyright notice and this permission notice shall be
+ *   included in all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#ifndef THREAD_OPTIONS_H_
+#define THREAD_OPTIONS_H_
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+#include <pthread.h>
+#include <sched.h>
+
+namespace task_control {
+
+/*
+ * How the thread of a named_task is set up. The CPU set, scheduling
+ * policy and stack size are given to pthread_create; a policy other than
+ * SCHED_OTHER usually takes CAP_SYS_NICE. The nice level and the name
+ * can only be set by the thread itself, and a name is cut to the 15
+ * characters Linux keeps. A task whose thread cannot be had with its
+ * options fails its init, with the error as the result of the task.
+ */
+struct thread_options {
+	thread_options();
+
+	// Pin to these CPUs, and to those of numa_node if it is not negative;
+	// with neither the thread runs wherever its creator may.
+	std::vector<int> cpus;
+	int numa_node;
+	// SCHED_OTHER inherits the creator's policy; SCHED_FIFO and SCHED_RR
+	// run at priority.
+	int policy;
+	int priority;
+	// Applied unless zero, with SCHED_OTHER.
+	int nice;
+	// Zero keeps the default.
+	std::size_t stack_size;
+	bool name_thread;
+
+	// Throws std::system_error if the thread cannot be created, and
+	// std::invalid_argument for a NUMA node that does not exist.
+	pthread_t spawn(std::function<void()> body) const;
+	// Sets what only the thread itself can set, on the calling thread.
+	void apply_here(const std::string& name) const;
+};
+
+// The CPUs of a NUMA node, as the kernel lists them in sysfs.
+std::vector<int> numa_node_cpus(int node);
+
+} /* namespace task_control */
+
+#endif /* THREAD_OPTIONS_H_ */
@@ -0,0 +1,78 @@
+/*
+ * watchdog.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Georgios Dimitriadis
+ *
+ * Copyright (C) 2026 Georgios Dimitriadis
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ *   The above copyright notice and this permission notice shall be
+ *   included in all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#include <task_control/watchdog.h>
+
+using namespace task_control;
+using namespace std;
+
+watchdog::watchdog(const chrono::milliseconds& slow_after, const chrono::milliseconds& stalled_after)
+	: slow_after_{slow_after},
+	  stalled_after_{stalled_after}
+{
+}
+
+watchdog::finding watchdog::check(const named_task& task, const chrono::steady_clock::time_point& now) const {
+	const auto& pulse = task.pulse();
+	finding found{&task, verdict::healthy, now - pulse.last(), pulse.progress(), chrono::steady_clock::duration::zero()};
+	const bool running = task.running();
+	{
+		lock_guard<mutex> lock{mutex_};
+		if(!running) {
+			seen_.erase(&task);
+		} else {
+			auto seen = seen_.find(&task);
+			if(seen == seen_.end())
+				seen_[&task] = progress_seen{found.progress, now};
+			else if(seen->second.progress != found.progress)
+				seen->second = progress_seen{found.progress, now};
+			else
+				found.no_progress_for = now - seen->second.since;
+		}
+	}
+
+	if(!running)
+		found.state = verdict::exited;
+	else if(stalled_after_.count() && found.silent_for >= stalled_after_)
+		found.state = verdict::stalled;
+	else if(slow_after_.count() && found.no_progress_for >= slow_after_)
+		found.state = verdict::slow;
+	return found;
+}
+
+size_t watchdog::check(const task_batch& batch, reporter_t report) const {
+	const auto now = chrono::steady_clock::now();
+	size_t unhealthy = 0;
+	batch.for_each([&](const named_task& task) {
+		auto found = check(task, now);
+		if(found.state != verdict::healthy) {
+			++unhealthy;
+			if(report)
+				report(found);
+		}
+	});
+	return unhealthy;
+}
@@ -0,0 +1,86 @@
+/*
+ * watchdog.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Georgios Dimitriadis
+ *
+ * Copyright (C) 2026 Georgios Dimitriadis
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ *   The above copyright notice and this permission notice shall be
+ *   included in all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#ifndef WATCHDOG_H_
+#define WATCHDOG_H_
+
+#include <task_control/task_batch.h>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <mutex>
+
+namespace task_control {
+
+/*
+ * Judges tasks by their heartbeats in one pass that never waits on them.
+ * A task that is not running has exited; a running task is stalled when
+ * it has not beaten for stalled_after and slow when its progress counter
+ * has not moved for slow_after. Progress is compared between checks: the
+ * watchdog keeps the last progress it saw of every task, so a task is
+ * only found slow from its second check on. A zero limit turns that check
+ * off, for tasks that do not beat or count progress while they run.
+ */
+class watchdog {
+public:
+	enum class verdict { healthy, slow, stalled, exited };
+
+	struct finding {
+		const named_task* task;
+		verdict state;
+		std::chrono::steady_clock::duration silent_for;
+		std::uint64_t progress;
+		std::chrono::steady_clock::duration no_progress_for;
+	};
+
+	typedef std::function<void(const finding&)> reporter_t;
+
+	watchdog(const std::chrono::milliseconds& slow_after, const std::chrono::milliseconds& stalled_after);
+	watchdog(const watchdog&) = delete;
+	watchdog& operator = (const watchdog&) = delete;
+
+	finding check(const named_task& task, const std::chrono::steady_clock::time_point& now) const;
+	// Reports the tasks that are not healthy and returns their number.
+	std::size_t check(const task_batch& batch, reporter_t report) const;
+
+private:
+	struct progress_seen {
+		std::uint64_t progress;
+		std::chrono::steady_clock::time_point since;
+	};
+
+	std::chrono::milliseconds slow_after_;
+	std::chrono::milliseconds stalled_after_;
+	mutable std::mutex mutex_;
+	mutable std::map<const named_task*, progress_seen> seen_;
+};
+
+} /* namespace task_control */
+
+#endif /* WATCHDOG_H_ */
@@ -0,0 +1,161 @@
+/*
+ * work_stealing_deque.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Georgios Dimitriadis
+ *
+ * Copyright (C) 2026 Georgios Dimitriadis
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ *   The above copyright notice and this permission notice shall be
+ *   included in all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#ifndef WORK_STEALING_DEQUE_H_
+#define WORK_STEALING_DEQUE_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace task_control {
+
+/*
+ * The Chase-Lev deque, with the memory orders of Le et al., "Correct and
+ * Efficient Work-Stealing for Weak Memory Models". One owner thread pushes
+ * and pops at the bottom, any thread steals from the top, none of them
+ * takes a lock. T is a pointer; nullptr means empty.
+ *
+ * The ring grows when it is full. Outgrown rings are kept until the deque
+ * goes away, since a thief may still be reading from one.
+ */
+template<typename T>
+class work_stealing_deque {
+public:
+	explicit work_stealing_deque(std::size_t capacity=256);
+	work_stealing_deque(const work_stealing_deque&) = delete;
+	work_stealing_deque& operator = (const work_stealing_deque&) = delete;
+
+	// Owner only.
+	void push(T item);
+	T pop();
+	// Any thread; nullptr when empty or when another thread won the race.
+	T steal();
+
+	bool empty() const;
+
+private:
+	struct ring {
+		explicit ring(std::size_t capacity) : mask{capacity - 1}, slots{new std::atomic<T>[capacity]} { }
+
+		std::size_t capacity() const { return mask + 1; }
+		T get(std::int64_t i) const { return slots[static_cast<std::size_t>(i) & mask].load(std::memory_order_relaxed); }
+		void put(std::int64_t i, T item) { slots[static_cast<std::size_t>(i) & mask].store(item, std::memory_order_relaxed); }
+
+		const std::size_t mask;
+		std::unique_ptr<std::atomic<T>[]> slots;
+	};
+
+	ring* grow(ring* full, std::int64_t top, std::int64_t bottom);
+
+	std::atomic<std::int64_t> top_;
+	std::atomic<std::int64_t> bottom_;
+	std::atomic<ring*> ring_;
+	std::vector<std::unique_ptr<ring>> rings_;
+};
+
+template<typename T>
+work_stealing_deque<T>::work_stealing_deque(std::size_t capacity)
+	: top_{0},
+	  bottom_{0}
+{
+	std::size_t rounded = 1;
+	while(rounded < capacity)
+		rounded <<= 1;
+	rings_.emplace_back(new ring{rounded});
+	ring_.store(rings_.back().get(), std::memory_order_relaxed);
+}
+
+template<typename T>
+void work_stealing_deque<T>::push(T item) {
+	const auto bottom = bottom_.load(std::memory_order_relaxed);
+	const auto top = top_.load(std::memory_order_acquire);
+	auto current = ring_.load(std::memory_order_relaxed);
+	if(bottom - top > static_cast<std::int64_t>(current->capacity()) - 1)
+		current = grow(current, top, bottom);
+	current->put(bottom, item);
+	std::atomic_thread_fence(std::memory_order_release);
+	bottom_.store(bottom + 1, std::memory_order_relaxed);
+}
+
+template<typename T>
+T work_stealing_deque<T>::pop() {
+	const auto bottom = bottom_.load(std::memory_order_relaxed) - 1;
+	auto current = ring_.load(std::memory_order_relaxed);
+	bottom_.store(bottom, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	auto top = top_.load(std::memory_order_relaxed);
+
+	T item = nullptr;
+	if(top <= bottom) {
+		item = current->get(bottom);
+		if(top == bottom) {
+			// The last item; a thief may be taking it too.
+			if(!top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+				item = nullptr;
+			bottom_.store(bottom + 1, std::memory_order_relaxed);
+		}
+	} else {
+		bottom_.store(bottom + 1, std::memory_order_relaxed);
+	}
+	return item;
+}
+
+template<typename T>
+T work_stealing_deque<T>::steal() {
+	auto top = top_.load(std::memory_order_acquire);
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	const auto bottom = bottom_.load(std::memory_order_acquire);
+	if(top >= bottom)
+		return nullptr;
+
+	T item = ring_.load(std::memory_order_acquire)->get(top);
+	if(!top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+		return nullptr;
+	return item;
+}
+
+template<typename T>
+bool work_stealing_deque<T>::empty() const {
+	return top_.load(std::memory_order_acquire) >= bottom_.load(std::memory_order_acquire);
+}
+
+template<typename T>
+typename work_stealing_deque<T>::ring* work_stealing_deque<T>::grow(ring* full, std::int64_t top, std::int64_t bottom) {
+	rings_.emplace_back(new ring{full->capacity() * 2});
+	auto grown = rings_.back().get();
+	for(auto i=top; i<bottom; ++i)
+		grown->put(i, full->get(i));
+	ring_.store(grown, std::memory_order_release);
+	return grown;
+}
+
+} /* namespace task_control */
+
+#endif /* WORK_STEALING_DEQUE_H_ */